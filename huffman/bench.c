@@ -0,0 +1,292 @@
+/*
+    Benchmark do compressor Huffman sobre um corpus sintético reproduzível.
+
+    Compila com: gcc -O2 bench.c huff.c -o bench -pthread
+    Uso: ./bench [-r repetições] [-m tamanho máximo] [-t threads] [-k tipo]
+
+    Corpus (gerado em memória, sempre igual para a mesma semente):
+        text    palavras de um vocabulário fixo com distribuição de Zipf, pontuação e quebras de linha
+        skewed  binário enviesado: poucos valores dominam, com 1/16 de bytes aleatórios
+        random  bytes uniformes (incompressível)
+        single  um único símbolo repetido
+    Tamanhos: 1K, 64K, 1M, 16M, 256M e 1G, limitados por -m (padrão 16M).
+
+    Cada caso roda em um processo filho, para que o pico de memória (RSS) seja só dele;
+    o resultado volta ao processo principal por um pipe.
+    A saída é uma linha JSON por caso, com o melhor tempo de -r repetições:
+        compress_mbps / decompress_mbps  API completa (huff_compress_buffer e
+                                         huff_decompress_buffer, formato em blocos)
+        ratio                            tamanho compactado / original
+        peak_rss_kb                      pico de RSS do processo filho
+        stages_ms                        etapas de ordem 0 sobre o buffer inteiro, em uma thread:
+                                         histograma, comprimentos (árvore), códigos e tabela
+                                         de decodificação, codificação e decodificação
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "huff.h"
+#include "huff_container.h"
+
+#define N_STAGES 5
+
+static const char *corpus_names[] = {"text", "skewed", "random", "single"};
+static const char *stage_names[N_STAGES] = {"histogram", "tree", "table", "encode", "decode"};
+static const uint64_t corpus_sizes[] = {1ull << 10, 1ull << 16, 1ull << 20, 1ull << 24, 1ull << 28, 1ull << 30};
+
+// Resultado de um caso, medido pelo processo filho.
+typedef struct {
+    int ok;
+    uint64_t compressed;
+    long peak_rss_kb;
+    double compress_time, decompress_time;
+    double stage_time[N_STAGES];
+} CaseResult;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Gerador xorshift: o corpus não depende de rand() nem da plataforma.
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void generate_text(unsigned char *data, size_t size, uint64_t *state) {
+    static const char *words[] = {
+        "de", "a", "o", "que", "e", "do", "da", "em", "um", "para", "com", "não", "uma", "os", "no",
+        "se", "na", "por", "mais", "as", "dos", "como", "mas", "ao", "ele", "das", "seu", "sua",
+        "compactador", "arquivo", "bloco", "tabela", "frequência", "árvore", "código", "bits",
+        "Huffman", "memória", "desempenho", "resultado", "entrada", "saída", "2024", "42"
+    };
+    const size_t n_words = sizeof(words) / sizeof(words[0]);
+    size_t pos = 0;
+
+    while (pos < size) {
+        // Zipf aproximado: o índice da palavra é o mínimo de dois sorteios uniformes.
+        uint64_t r = next_random(state);
+        size_t a = (r & 0xFFFF) % n_words, b = ((r >> 16) & 0xFFFF) % n_words;
+        const char *word = words[a < b ? a : b];
+
+        for (size_t k = 0; word[k] && pos < size; k++) data[pos++] = (unsigned char)word[k];
+        if (pos < size) {
+            int kind = (r >> 32) & 31;
+            data[pos++] = kind == 0 ? '\n' : kind == 1 ? ',' : kind == 2 ? '.' : ' ';
+        }
+    }
+}
+
+static void generate_skewed(unsigned char *data, size_t size, uint64_t *state) {
+    for (size_t i = 0; i < size; i++) {
+        uint64_t r = next_random(state);
+        // Valor k com probabilidade ~2^-(k+1); um em 16 bytes é uniforme.
+        data[i] = (r >> 60) == 0 ? (unsigned char)(r >> 8) : (unsigned char)__builtin_ctzll(r | (1ull << 40));
+    }
+}
+
+static void generate_random(unsigned char *data, size_t size, uint64_t *state) {
+    for (size_t i = 0; i < size; i++) data[i] = (unsigned char)(next_random(state) >> 24);
+}
+
+static void generate_corpus(int kind, unsigned char *data, size_t size) {
+    uint64_t state = 0x9E3779B97F4A7C15ull ^ (uint64_t)kind;
+    if (kind == 0) generate_text(data, size, &state);
+    else if (kind == 1) generate_skewed(data, size, &state);
+    else if (kind == 2) generate_random(data, size, &state);
+    else memset(data, 'a', size);
+}
+
+// Etapas do codificador de ordem 0 sobre o buffer inteiro; acumula o melhor tempo de cada uma.
+static int run_stages(const unsigned char *data, size_t size, double best[N_STAGES]) {
+    BlockCode code = {0};
+    uint64_t freq[256] = {0};
+    double elapsed[N_STAGES];
+
+    double start = now_seconds();
+    count_frequencies(data, size, freq);
+    elapsed[0] = now_seconds() - start;
+
+    start = now_seconds();
+    compute_code_lengths(freq, DEFAULT_MAX_CODE_LENGTH, code.lengths);
+    elapsed[1] = now_seconds() - start;
+
+    start = now_seconds();
+    assign_canonical_codes(code.lengths, code.huff_table);
+    int ok = block_code_prepare_decode(&code) == 0;
+    elapsed[2] = now_seconds() - start;
+
+    // Os buffers ficam fora da medição; os bits cabem exatamente em sum(freq * comprimento).
+    uint64_t bits = 0;
+    for (int c = 0; c < 256; c++) bits += freq[c] * code.lengths[c];
+    unsigned char *payload = malloc(bits / 8 + 8);
+    unsigned char *decoded = malloc(size);
+
+    start = now_seconds();
+    size_t payload_len = encode_block(data, size, code.huff_table, payload);
+    elapsed[3] = now_seconds() - start;
+
+    start = now_seconds();
+    ok = ok && decode_block(code.decode_table, code.tree, payload, payload_len, decoded, size) == size;
+    elapsed[4] = now_seconds() - start;
+
+    ok = ok && memcmp(decoded, data, size) == 0;
+    for (int s = 0; s < N_STAGES; s++) {
+        if (elapsed[s] < best[s]) best[s] = elapsed[s];
+    }
+
+    block_code_free(&code);
+    free(decoded);
+    free(payload);
+    return ok;
+}
+
+// Executa um caso (no processo filho) e preenche result.
+static void run_case(int kind, size_t size, int repetitions, const HuffOptions *options, CaseResult *result) {
+    unsigned char *data = malloc(size);
+    generate_corpus(kind, data, size);
+
+    result->ok = 1;
+    result->compress_time = result->decompress_time = 1e30;
+    for (int s = 0; s < N_STAGES; s++) result->stage_time[s] = 1e30;
+
+    for (int r = 0; r < repetitions && result->ok; r++) {
+        unsigned char *packed = NULL, *unpacked = NULL;
+        size_t packed_size = 0, unpacked_size = 0;
+
+        double start = now_seconds();
+        if (huff_compress_buffer(data, size, &packed, &packed_size, options) != 0) {
+            result->ok = 0;
+            break;
+        }
+        double middle = now_seconds();
+        if (huff_decompress_buffer(packed, packed_size, &unpacked, &unpacked_size, options) != 0) {
+            free(packed);
+            result->ok = 0;
+            break;
+        }
+        double end = now_seconds();
+
+        result->ok = unpacked_size == size && memcmp(unpacked, data, size) == 0;
+        result->compressed = packed_size;
+        if (middle - start < result->compress_time) result->compress_time = middle - start;
+        if (end - middle < result->decompress_time) result->decompress_time = end - middle;
+        free(packed);
+        free(unpacked);
+
+        result->ok = result->ok && run_stages(data, size, result->stage_time);
+    }
+
+    free(data);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result->peak_rss_kb = usage.ru_maxrss;
+}
+
+// Lê um tamanho como "64K", "16M" ou "1G". Retorna 0 se o valor for inválido.
+static uint64_t parse_size(const char *text) {
+    char *end;
+    uint64_t value = strtoull(text, &end, 10);
+    if (*end == 'K' || *end == 'k') { value <<= 10; end++; }
+    else if (*end == 'M' || *end == 'm') { value <<= 20; end++; }
+    else if (*end == 'G' || *end == 'g') { value <<= 30; end++; }
+    return *end == '\0' ? value : 0;
+}
+
+static void print_case(int kind, uint64_t size, int repetitions, const CaseResult *result) {
+    double mb = size / 1e6;
+    printf("{\"corpus\":\"%s\",\"size\":%llu,\"repetitions\":%d,\"ok\":%s,\"compressed\":%llu,"
+           "\"ratio\":%.4f,\"compress_mbps\":%.1f,\"decompress_mbps\":%.1f,\"peak_rss_kb\":%ld,\"stages_ms\":{",
+           corpus_names[kind], (unsigned long long)size, repetitions, result->ok ? "true" : "false",
+           (unsigned long long)result->compressed, (double)result->compressed / size,
+           mb / result->compress_time, mb / result->decompress_time, result->peak_rss_kb);
+    for (int s = 0; s < N_STAGES; s++) {
+        printf("%s\"%s\":%.3f", s ? "," : "", stage_names[s], result->stage_time[s] * 1e3);
+    }
+    printf("}}\n");
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+    int repetitions = 3;
+    uint64_t max_size = 16ull << 20;
+    int only_kind = -1;
+    HuffOptions options;
+    huff_default_options(&options);
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:m:t:k:h")) != -1) {
+        switch (opt) {
+            case 'r': repetitions = atoi(optarg); break;
+            case 'm': max_size = parse_size(optarg); break;
+            case 't': options.threads = atoi(optarg); break;
+            case 'k':
+                for (int k = 0; k < 4; k++) {
+                    if (strcmp(optarg, corpus_names[k]) == 0) only_kind = k;
+                }
+                if (only_kind < 0) {
+                    fprintf(stderr, "Tipo de corpus desconhecido: %s\n", optarg);
+                    return 2;
+                }
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-r repetições] [-m tamanho máximo (ex.: 1G)] [-t threads] "
+                                "[-k text|skewed|random|single]\n", argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (repetitions < 1 || max_size == 0) {
+        fprintf(stderr, "Repetições e tamanho máximo precisam ser positivos\n");
+        return 2;
+    }
+
+    int failures = 0;
+    for (int kind = 0; kind < 4; kind++) {
+        if (only_kind >= 0 && kind != only_kind) continue;
+
+        for (size_t i = 0; i < sizeof(corpus_sizes) / sizeof(corpus_sizes[0]); i++) {
+            uint64_t size = corpus_sizes[i];
+            if (size > max_size) break;
+
+            CaseResult result = {0};
+            int channel[2];
+            fflush(stdout);
+            pid_t pid = pipe(channel) == 0 ? fork() : -1;
+            if (pid < 0) {
+                perror("fork");
+                return 1;
+            }
+            if (pid == 0) {
+                close(channel[0]);
+                run_case(kind, (size_t)size, repetitions, &options, &result);
+                ssize_t written = write(channel[1], &result, sizeof(result));
+                _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+            }
+
+            close(channel[1]);
+            int status;
+            if (read(channel[0], &result, sizeof(result)) != (ssize_t)sizeof(result) ||
+                waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                result.ok = 0;
+            }
+            close(channel[0]);
+            if (!result.ok) failures++;
+            print_case(kind, size, repetitions, &result);
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/*
+    Micro-benchmark das filas de prioridade de pqueue_heap.h.
+
+    Compila com: gcc -O2 heap_bench.c -o heap_bench
+    Uso: ./heap_bench [repetições]
+
+    1. Construção da árvore de Huffman com 256 símbolos: PRIORITY_QUEUE (binário,
+       recursivo, chaves lidas pela árvore), D_HEAP (4-ário, iterativo, chave ao lado
+       do id, montado com heap_build) e build_huffman_tree_sorted (duas filas, sem heap).
+    2. Operações em volume, que a fila antiga (fixa em 256) não comporta:
+       push/pop de um milhão de chaves e uma rodada de decrease-key no estilo Dijkstra.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "huffman.h"
+#include "pqueue_heap.h"
+
+#define LARGE_COUNT 1000000
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Gerador xorshift: frequências reproduzíveis sem depender de rand().
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Árvore de Huffman com a fila original. Retorna a frequência da raiz (soma de todas).
+static uint64_t build_with_priority_queue(const uint64_t freq[256], HUFF_TREE *tree) {
+    tree_reset(tree);
+    PRIORITY_QUEUE *pq = create_queue(tree);
+    create_huff_queue_from_freq(tree, freq, &pq);
+    uint16_t root = build_huffman_tree(tree, pq);
+    free_priority_queue(pq);
+    return tree->nodes[root].frequency;
+}
+
+// Mesma construção com o heap 4-ário: as folhas entram de uma vez por heap_build.
+static uint64_t build_with_d_heap(const uint64_t freq[256], HUFF_TREE *tree, D_HEAP *heap) {
+    HEAP_ENTRY leaves[256];
+    size_t n = 0;
+    tree_reset(tree);
+    for (int c = 0; c < 256; c++) {
+        if (freq[c] > 0) {
+            leaves[n++] = (HEAP_ENTRY){freq[c], create_node(tree, c, freq[c], TREE_NIL, TREE_NIL)};
+        }
+    }
+    heap_build(heap, leaves, n);
+
+    HEAP_ENTRY left = {0, TREE_NIL}, right;
+    while (heap->size > 1) {
+        heap_pop(heap, &left);
+        heap_pop(heap, &right);
+        uint16_t parent = create_node(tree, '\0', left.key + right.key, left.id, right.id);
+        heap_push(heap, left.key + right.key, parent);
+    }
+    heap_pop(heap, &left);
+    return left.key;
+}
+
+int main(int argc, char *argv[]) {
+    int repetitions = argc > 1 ? atoi(argv[1]) : 200000;
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    uint64_t freq[256];
+    for (int c = 0; c < 256; c++) {
+        freq[c] = 1 + next_random(&state) % 100000;
+    }
+
+    HUFF_TREE *tree = malloc(sizeof(HUFF_TREE));
+    D_HEAP heap;
+    heap_init(&heap, 512, 0);
+
+    // 1. Construção da árvore de Huffman
+    uint64_t check_pq = 0, check_heap = 0;
+    double start = now_seconds();
+    for (int r = 0; r < repetitions; r++) check_pq += build_with_priority_queue(freq, tree);
+    double pq_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int r = 0; r < repetitions; r++) check_heap += build_with_d_heap(freq, tree, &heap);
+    double heap_time = now_seconds() - start;
+
+    uint64_t check_sorted = 0;
+    start = now_seconds();
+    for (int r = 0; r < repetitions; r++) check_sorted += tree->nodes[build_huffman_tree_sorted(tree, freq)].frequency;
+    double sorted_time = now_seconds() - start;
+
+    printf("arvore de Huffman (256 simbolos, %d vezes)\n", repetitions);
+    printf("  PRIORITY_QUEUE: %8.0f ns por arvore\n", pq_time / repetitions * 1e9);
+    printf("  D_HEAP:         %8.0f ns por arvore (%.2fx)%s\n", heap_time / repetitions * 1e9,
+           pq_time / heap_time, check_pq == check_heap ? "" : "  ERRO: raizes diferentes");
+    printf("  duas filas:     %8.0f ns por arvore (%.2fx)%s\n", sorted_time / repetitions * 1e9,
+           pq_time / sorted_time, check_pq == check_sorted ? "" : "  ERRO: raizes diferentes");
+
+    // 2. Volume: push de LARGE_COUNT chaves aleatórias e pop de todas, conferindo a ordem.
+    heap_free(&heap);
+    heap_init(&heap, 0, 0);
+    start = now_seconds();
+    for (uint32_t i = 0; i < LARGE_COUNT; i++) heap_push(&heap, next_random(&state), i);
+    double push_time = now_seconds() - start;
+
+    int ordered = 1;
+    uint64_t last = 0;
+    HEAP_ENTRY entry;
+    start = now_seconds();
+    while (heap_pop(&heap, &entry) == 0) {
+        if (entry.key < last) ordered = 0;
+        last = entry.key;
+    }
+    double pop_time = now_seconds() - start;
+
+    printf("volume (%d chaves)\n", LARGE_COUNT);
+    printf("  push: %6.1f ns  pop: %6.1f ns%s\n", push_time / LARGE_COUNT * 1e9,
+           pop_time / LARGE_COUNT * 1e9, ordered ? "" : "  ERRO: ordem incorreta");
+
+    // 3. Decrease-key: heap_build com todas as chaves e uma redução aleatória por id.
+    heap_free(&heap);
+    heap_init(&heap, LARGE_COUNT, 1);
+    HEAP_ENTRY *entries = malloc(LARGE_COUNT * sizeof(HEAP_ENTRY));
+    for (uint32_t i = 0; i < LARGE_COUNT; i++) {
+        entries[i] = (HEAP_ENTRY){UINT64_MAX / 2 + next_random(&state) % 1000000, i};
+    }
+
+    start = now_seconds();
+    heap_build(&heap, entries, LARGE_COUNT);
+    double build_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < LARGE_COUNT; i++) {
+        heap_decrease_key(&heap, (uint32_t)(next_random(&state) % LARGE_COUNT), next_random(&state) % (UINT64_MAX / 2));
+    }
+    double decrease_time = now_seconds() - start;
+
+    ordered = 1;
+    last = 0;
+    while (heap_pop(&heap, &entry) == 0) {
+        if (entry.key < last) ordered = 0;
+        last = entry.key;
+    }
+
+    printf("indexado (%d chaves)\n", LARGE_COUNT);
+    printf("  heap_build: %6.1f ns por chave  decrease-key: %6.1f ns%s\n", build_time / LARGE_COUNT * 1e9,
+           decrease_time / LARGE_COUNT * 1e9, ordered ? "" : "  ERRO: ordem incorreta");
+
+    free(entries);
+    free(tree);
+    heap_free(&heap);
+    return 0;
+}
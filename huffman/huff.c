@@ -0,0 +1,312 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "huff.h"
+#include "huffman.h"
+#include "pqueue_heap.h"
+#include "huff_container.h"
+#include "huff_mmap.h"
+
+struct HuffArchiveHandle {
+    HuffArchive *archive;
+};
+
+void huff_default_options(HuffOptions *options) {
+    memset(options, 0, sizeof(*options));
+}
+
+static const HuffOptions* options_or_default(const HuffOptions *options, HuffOptions *defaults) {
+    if (options) return options;
+    huff_default_options(defaults);
+    return defaults;
+}
+
+static int container_flags(const HuffOptions *options) {
+    return (options->block_tables ? CONTAINER_FLAG_BLOCK_TABLES : 0) |
+           (options->context ? CONTAINER_FLAG_CONTEXT : 0);
+}
+
+// Núcleo comum às versões por descritor e por caminho.
+static int compress_stream(FILE *input, FILE *output, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    if (options->format == HUFF_FORMAT_LEGACY) {
+        return legacy_compress(input, output);
+    }
+    return container_compress(input, output, options->threads, options->block_size,
+                              options->max_code_length, container_flags(options));
+}
+
+static int decompress_stream(FILE *input, FILE *output, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    // Sem seek (pipe) não há como voltar depois de ler a assinatura: só o formato em blocos.
+    if (fseek(input, 0, SEEK_CUR) == 0 && !is_container_file(input)) {
+        return legacy_decompress(input, output);
+    }
+    return container_decompress(input, output, options->threads);
+}
+
+static int verify_stream(FILE *input, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    // O formato original não tem checksum: conferir é decodificar e descartar a saída.
+    if (fseek(input, 0, SEEK_CUR) == 0 && !is_container_file(input)) {
+        FILE *sink = fopen("/dev/null", "wb");
+        if (!sink) {
+            perror("/dev/null");
+            return -1;
+        }
+        int status = legacy_decompress(input, sink);
+        fclose(sink);
+        return status;
+    }
+    return container_verify(input, options->threads);
+}
+
+// Abre cópias dos descritores como FILE*, para que fclose() não feche os originais.
+static int with_fd_streams(int input_fd, int output_fd, const HuffOptions *options,
+                           int (*run)(FILE*, FILE*, const HuffOptions*)) {
+    int in_copy = dup(input_fd), out_copy = dup(output_fd);
+    FILE *input = in_copy >= 0 ? fdopen(in_copy, "rb") : NULL;
+    FILE *output = out_copy >= 0 ? fdopen(out_copy, "wb") : NULL;
+
+    if (!input || !output) {
+        perror("Erro ao abrir os descritores");
+        if (input) fclose(input); else if (in_copy >= 0) close(in_copy);
+        if (output) fclose(output); else if (out_copy >= 0) close(out_copy);
+        return -1;
+    }
+
+    int status = run(input, output, options);
+    fclose(input);
+    if (fclose(output) != 0) status = -1;
+    return status;
+}
+
+int huff_compress_fd(int input_fd, int output_fd, const HuffOptions *options) {
+    return with_fd_streams(input_fd, output_fd, options, compress_stream);
+}
+
+int huff_decompress_fd(int input_fd, int output_fd, const HuffOptions *options) {
+    return with_fd_streams(input_fd, output_fd, options, decompress_stream);
+}
+
+int huff_verify_fd(int input_fd, const HuffOptions *options) {
+    int in_copy = dup(input_fd);
+    FILE *input = in_copy >= 0 ? fdopen(in_copy, "rb") : NULL;
+    if (!input) {
+        perror("Erro ao abrir o descritor");
+        if (in_copy >= 0) close(in_copy);
+        return -1;
+    }
+
+    int status = verify_stream(input, options);
+    fclose(input);
+    return status;
+}
+
+static int with_file_streams(const char *input_path, const char *output_path, const HuffOptions *options,
+                             int (*run)(FILE*, FILE*, const HuffOptions*)) {
+    FILE *input = fopen(input_path, "rb");
+    if (!input) {
+        perror(input_path);
+        return -1;
+    }
+
+    FILE *output = fopen(output_path, "wb");
+    if (!output) {
+        perror(output_path);
+        fclose(input);
+        return -1;
+    }
+
+    int status = run(input, output, options);
+    fclose(input);
+    if (fclose(output) != 0) status = -1;
+    return status;
+}
+
+// Compacta a partir do mapeamento da entrada. Retorna 1 se a entrada não puder ser mapeada.
+static int compress_file_mapped(const char *input_path, const char *output_path, const HuffOptions *options) {
+    int fd = open(input_path, O_RDONLY);
+    MappedFile map;
+    if (fd < 0 || map_input_file(fd, &map) != 0) {
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    FILE *output = fopen(output_path, "wb");
+    int status = -1;
+    if (!output) {
+        perror(output_path);
+    } else if (options->format == HUFF_FORMAT_LEGACY) {
+        status = legacy_compress_buffer(map.data, map.size, output);
+    } else {
+        status = container_compress_buffer(map.data, map.size, output, options->threads, options->block_size,
+                                           options->max_code_length, container_flags(options));
+    }
+    if (output && fclose(output) != 0) status = -1;
+
+    unmap_file(&map);
+    close(fd);
+    return status;
+}
+
+// Descompacta um contêiner mapeado direto para a saída mapeada.
+// Retorna 1 se a entrada não puder ser mapeada ou não for um contêiner com índice.
+static int decompress_file_mapped(const char *input_path, const char *output_path, const HuffOptions *options) {
+    int fd = open(input_path, O_RDONLY);
+    MappedFile map;
+    if (fd < 0 || map_input_file(fd, &map) != 0) {
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    int status = container_decompress_mapped(map.data, map.size, output_path, options->threads);
+    unmap_file(&map);
+    close(fd);
+    return status;
+}
+
+int huff_compress_file(const char *input_path, const char *output_path, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    if (!options->no_mmap) {
+        int status = compress_file_mapped(input_path, output_path, options);
+        if (status != 1) return status;
+    }
+    return with_file_streams(input_path, output_path, options, compress_stream);
+}
+
+int huff_decompress_file(const char *input_path, const char *output_path, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    if (!options->no_mmap) {
+        int status = decompress_file_mapped(input_path, output_path, options);
+        if (status != 1) return status;
+    }
+    return with_file_streams(input_path, output_path, options, decompress_stream);
+}
+
+int huff_verify_file(const char *path, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    if (!options->no_mmap) {
+        int fd = open(path, O_RDONLY);
+        MappedFile map;
+        if (fd >= 0 && map_input_file(fd, &map) == 0) {
+            int status = container_verify_mapped(map.data, map.size, options->threads);
+            unmap_file(&map);
+            close(fd);
+            if (status != 1) return status;
+        } else if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    FILE *input = fopen(path, "rb");
+    if (!input) {
+        perror(path);
+        return -1;
+    }
+    int status = verify_stream(input, options);
+    fclose(input);
+    return status;
+}
+
+int huff_compress_buffer(const void *input, size_t input_size,
+                         unsigned char **output, size_t *output_size, const HuffOptions *options) {
+    HuffOptions defaults;
+    options = options_or_default(options, &defaults);
+
+    char *buffer = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&buffer, &size);
+    if (!out) {
+        perror("Erro ao criar o buffer de saída");
+        return -1;
+    }
+
+    int status;
+    if (options->format == HUFF_FORMAT_LEGACY) {
+        status = legacy_compress_buffer(input, input_size, out);
+    } else {
+        status = container_compress_buffer(input, input_size, out, options->threads, options->block_size,
+                                           options->max_code_length, container_flags(options));
+    }
+
+    if (fclose(out) != 0) status = -1;
+    if (status != 0) {
+        free(buffer);
+        return -1;
+    }
+
+    *output = (unsigned char *)buffer;
+    *output_size = size;
+    return 0;
+}
+
+int huff_decompress_buffer(const void *input, size_t input_size,
+                           unsigned char **output, size_t *output_size, const HuffOptions *options) {
+    if (input_size == 0) {
+        fprintf(stderr, "Erro: buffer compactado vazio\n");
+        return -1;
+    }
+
+    FILE *in = fmemopen((void *)input, input_size, "rb");
+    char *buffer = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&buffer, &size);
+    if (!in || !out) {
+        perror("Erro ao criar os buffers");
+        if (in) fclose(in);
+        if (out) fclose(out);
+        free(buffer);
+        return -1;
+    }
+
+    int status = decompress_stream(in, out, options);
+    fclose(in);
+    if (fclose(out) != 0) status = -1;
+    if (status != 0) {
+        free(buffer);
+        return -1;
+    }
+
+    *output = (unsigned char *)buffer;
+    *output_size = size;
+    return 0;
+}
+
+HuffArchiveHandle* huff_archive_open(const char *path) {
+    HuffArchive *archive = archive_open(path);
+    if (!archive) return NULL;
+
+    HuffArchiveHandle *handle = malloc(sizeof(HuffArchiveHandle));
+    handle->archive = archive;
+    return handle;
+}
+
+uint64_t huff_archive_size(const HuffArchiveHandle *handle) {
+    return handle->archive->total_size;
+}
+
+size_t huff_archive_read(HuffArchiveHandle *handle, uint64_t offset, void *output, size_t length) {
+    return archive_read(handle->archive, offset, output, length);
+}
+
+void huff_archive_close(HuffArchiveHandle *handle) {
+    if (!handle) return;
+    archive_close(handle->archive);
+    free(handle);
+}
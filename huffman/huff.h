@@ -0,0 +1,68 @@
+#ifndef HUFF_H
+#define HUFF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    API pública do compressor Huffman (biblioteca libhuff).
+
+    Todas as funções retornam 0 em caso de sucesso e -1 em caso de erro; a
+    mensagem de erro é escrita em stderr. Os detalhes de implementação ficam em
+    huffman.h, pqueue_heap.h e huff_container.h, incluídos apenas por huff.c.
+*/
+
+// Formato de saída da compactação.
+enum {
+    HUFF_FORMAT_CONTAINER = 0,  // blocos independentes com índice (padrão)
+    HUFF_FORMAT_LEGACY = 1      // formato original: cabeçalho de 2 bytes + árvore + bits
+};
+
+typedef struct {
+    int format;             // HUFF_FORMAT_*
+    int threads;            // 0 = todos os núcleos
+    uint32_t block_size;    // 0 = 1 MiB; no máximo 256 MiB
+    int max_code_length;    // 0 = 15 bits
+    int block_tables;       // 1 = tabela própria em cada bloco (modo fluxo)
+    int context;            // 1 = até 4 tabelas por bloco, escolhidas pela classe do byte anterior
+    int no_mmap;            // 1 = não mapeia arquivos regulares; usa só stdio
+} HuffOptions;
+
+// Opções padrão (equivalente a um HuffOptions zerado).
+void huff_default_options(HuffOptions *options);
+
+// Compacta/descompacta entre descritores de arquivo (arquivos, pipes, sockets).
+// Os descritores não são fechados. A descompactação reconhece os dois formatos
+// quando a entrada permite seek; em pipes, espera o formato em blocos.
+int huff_compress_fd(int input_fd, int output_fd, const HuffOptions *options);
+int huff_decompress_fd(int input_fd, int output_fd, const HuffOptions *options);
+
+// Compacta/descompacta entre caminhos de arquivo. Arquivos regulares são mapeados
+// em memória (mmap), a menos que options->no_mmap seja 1.
+int huff_compress_file(const char *input_path, const char *output_path, const HuffOptions *options);
+int huff_decompress_file(const char *input_path, const char *output_path, const HuffOptions *options);
+
+// Confere um arquivo compactado sem gravar a saída. Retorna 0 se estiver íntegro.
+// No formato em blocos confere o CRC32C de cada bloco, o índice e o rodapé, sem
+// decodificar (arquivos anteriores aos checksums são decodificados e descartados).
+// O formato original não tem checksum: só a árvore e a decodificação são conferidas.
+int huff_verify_fd(int input_fd, const HuffOptions *options);
+int huff_verify_file(const char *path, const HuffOptions *options);
+
+// Compacta/descompacta um buffer em memória. *output é alocado com malloc e
+// deve ser liberado pelo chamador com free().
+int huff_compress_buffer(const void *input, size_t input_size,
+                         unsigned char **output, size_t *output_size, const HuffOptions *options);
+int huff_decompress_buffer(const void *input, size_t input_size,
+                           unsigned char **output, size_t *output_size, const HuffOptions *options);
+
+// Leitura de intervalos de um arquivo no formato em blocos, sem descompactá-lo inteiro.
+typedef struct HuffArchiveHandle HuffArchiveHandle;
+
+HuffArchiveHandle* huff_archive_open(const char *path);
+uint64_t huff_archive_size(const HuffArchiveHandle *archive);
+// Retorna quantos bytes foram copiados (menos que length no fim do arquivo ou em erro).
+size_t huff_archive_read(HuffArchiveHandle *archive, uint64_t offset, void *output, size_t length);
+void huff_archive_close(HuffArchiveHandle *archive);
+
+#endif // HUFF_H
@@ -0,0 +1,1233 @@
+#ifndef HUFF_CONTAINER_H
+#define HUFF_CONTAINER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "huffman.h"
+#include "crc32c.h"
+
+/*
+    CONTÊINER .huff EM BLOCOS (compactação e descompactação multi-thread)
+
+    Layout (inteiros em little-endian):
+        "HUFC" | versão (u8) | flags (u8) | tamanho do bloco (u32)
+               | comprimento do código de cada byte (256 x u8, só sem CONTAINER_FLAG_BLOCK_TABLES)
+               | CRC32C do cabeçalho (u32, só com CONTAINER_FLAG_CHECKSUM)
+        blocos: tamanho original (u32) | bytes compactados (u32)
+                | comprimentos do bloco (256 x u8, só com CONTAINER_FLAG_BLOCK_TABLES)
+                  ou, com CONTAINER_FLAG_CONTEXT: número de tabelas n (u8) | tabela de cada
+                  classe de contexto (4 x 2 bits) | n x 256 comprimentos
+                | bits
+                | CRC32C do bloco (u32, só com CONTAINER_FLAG_CHECKSUM), calculado sobre
+                  todos os campos anteriores do bloco, desde o tamanho original
+        fim:    u32 0
+        índice: número de blocos (u64) | offset de cada bloco no arquivo (u64)
+        rodapé: tamanho original total (u64) | offset do índice (u64) | "HUFX"
+
+    Os códigos são canônicos: os 256 comprimentos bastam para reconstruí-los.
+    Versões anteriores continuam legíveis: a 1 guardava a árvore em pré-ordem
+    (write_tree), a 2 não tinha o byte de flags, a 3 não tinha o modelo de contexto
+    e a 4 não tinha checksums. Arquivos novos sempre saem com CONTAINER_FLAG_CHECKSUM.
+
+    Sem flags, todos os blocos usam a mesma tabela (histogramas somados). Com
+    CONTAINER_FLAG_BLOCK_TABLES cada bloco tem a própria tabela, o que permite
+    compactar um fluxo (pipe) em uma única passada com memória constante; o
+    decodificador lê só para frente e para no marcador de fim.
+
+    Em ambos os casos cada bloco é decodificado de forma independente. Todo bloco,
+    exceto o último, tem exatamente "tamanho do bloco" bytes originais, então o byte
+    x do arquivo original está no bloco x / tamanho do bloco, cujo offset vem do índice.
+*/
+
+#define CONTAINER_MAGIC "HUFC"
+#define CONTAINER_FOOTER_MAGIC "HUFX"
+#define CONTAINER_VERSION 5
+#define CONTAINER_VERSION_TREE 1
+#define CONTAINER_VERSION_FLAGS 3
+#define CONTAINER_VERSION_CONTEXT 4
+#define CONTAINER_VERSION_CHECKSUM 5
+#define CONTAINER_FOOTER_SIZE 20
+#define CONTAINER_FLAG_BLOCK_TABLES 0x01
+#define CONTAINER_FLAG_CONTEXT 0x02
+#define CONTAINER_FLAG_CHECKSUM 0x04
+#define CONTAINER_KNOWN_FLAGS (CONTAINER_FLAG_BLOCK_TABLES | CONTAINER_FLAG_CONTEXT | CONTAINER_FLAG_CHECKSUM)
+#define DEFAULT_BLOCK_SIZE (1u << 20)
+#define MAX_BLOCK_SIZE (1u << 28)       // o cabeçalho não é confiável: limita o buffer de cada bloco
+#define CHUNKS_PER_THREAD 4
+
+static inline void write_u32(FILE *file, uint32_t value) {
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++) bytes[i] = (unsigned char)(value >> (8 * i));
+    fwrite(bytes, 1, 4, file);
+}
+
+static inline void write_u64(FILE *file, uint64_t value) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = (unsigned char)(value >> (8 * i));
+    fwrite(bytes, 1, 8, file);
+}
+
+static inline int read_u32(FILE *file, uint32_t *value) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, file) != 4) return 0;
+    *value = 0;
+    for (int i = 0; i < 4; i++) *value |= (uint32_t)bytes[i] << (8 * i);
+    return 1;
+}
+
+static inline int read_u64(FILE *file, uint64_t *value) {
+    unsigned char bytes[8];
+    if (fread(bytes, 1, 8, file) != 8) return 0;
+    *value = 0;
+    for (int i = 0; i < 8; i++) *value |= (uint64_t)bytes[i] << (8 * i);
+    return 1;
+}
+
+// Codifica um bloco direto em memória. "out" precisa de espaço para o pior caso.
+static inline size_t encode_block(const unsigned char *data, size_t size, HuffmanCode huff_table[256], unsigned char *out) {
+    uint64_t acc = 0;
+    int bits = 0;
+    size_t used = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        HuffmanCode code = huff_table[data[i]];
+        acc = (acc << code.length) | code.code;
+        bits += code.length;
+
+        if (bits >= 32) {
+            out[used++] = (unsigned char)(acc >> (bits - 8));
+            out[used++] = (unsigned char)(acc >> (bits - 16));
+            out[used++] = (unsigned char)(acc >> (bits - 24));
+            out[used++] = (unsigned char)(acc >> (bits - 32));
+            bits -= 32;
+        }
+    }
+
+    while (bits >= 8) {
+        out[used++] = (unsigned char)(acc >> (bits - 8));
+        bits -= 8;
+    }
+    if (bits > 0) {
+        out[used++] = (unsigned char)(acc << (8 - bits));
+    }
+
+    return used;
+}
+
+// Decodifica exatamente raw_len símbolos de um bloco em memória.
+// Retorna quantos símbolos foram produzidos (menos que raw_len se o bloco acabar antes).
+static inline size_t decode_block(const DecodeTable *table, const HUFF_TREE *tree, const unsigned char *in, size_t in_len,
+                    unsigned char *out, size_t raw_len) {
+    const NODE *nodes = tree->nodes;
+    if (is_leaf(tree, tree->root)) {
+        memset(out, nodes[tree->root].character, raw_len);
+        return raw_len;
+    }
+
+    uint64_t acc = 0;
+    int bits = 0;
+    size_t pos = 0, produced = 0;
+
+    while (produced < raw_len) {
+        while (bits <= 56 && pos < in_len) {
+            acc |= (uint64_t)in[pos++] << (56 - bits);
+            bits += 8;
+        }
+
+        uint16_t current = tree->root;
+        if (bits >= DECODE_TABLE_BITS && produced + DECODE_MAX_SYMBOLS <= raw_len) {
+            const DecodeEntry *entry = &table->entries[acc >> (64 - DECODE_TABLE_BITS)];
+            acc <<= entry->bits;
+            bits -= entry->bits;
+
+            if (entry->count > 0) {
+                memcpy(out + produced, entry->symbols, DECODE_MAX_SYMBOLS);
+                produced += entry->count;
+                continue;
+            }
+            current = entry->node;
+        }
+
+        // Códigos longos e o final do bloco seguem a árvore bit a bit.
+        while (!is_leaf(tree, current)) {
+            if (bits == 0) {
+                if (pos == in_len) return produced;
+                acc = (uint64_t)in[pos++] << 56;
+                bits = 8;
+            }
+            current = (acc >> 63) ? nodes[current].right : nodes[current].left;
+            acc <<= 1;
+            bits--;
+        }
+        out[produced++] = nodes[current].character;
+    }
+
+    return produced;
+}
+
+// Tabela de códigos de um bloco (ou do arquivo inteiro), para codificar e decodificar.
+typedef struct {
+    uint8_t lengths[256];
+    HuffmanCode huff_table[256];
+    HUFF_TREE *tree;         // alocada na primeira decodificação e reaproveitada nos blocos seguintes
+    DecodeTable *decode_table;
+} BlockCode;
+
+// Calcula comprimentos e códigos canônicos a partir de um histograma.
+static inline void block_code_from_freq(BlockCode *code, const uint64_t freq[256], int max_code_length) {
+    compute_code_lengths(freq, max_code_length, code->lengths);
+    assign_canonical_codes(code->lengths, code->huff_table);
+}
+
+// Árvore vazia do decodificador, alocada uma única vez por BlockCode.
+static inline HUFF_TREE* block_code_tree(BlockCode *code) {
+    if (!code->tree) code->tree = malloc(sizeof(HUFF_TREE));
+    if (!code->decode_table) code->decode_table = malloc(sizeof(DecodeTable));
+    tree_reset(code->tree);
+    return code->tree;
+}
+
+// Refaz a tabela de decodificação depois que code->tree foi preenchida.
+static inline int block_code_finish_tree(BlockCode *code) {
+    if (code->tree->root == TREE_NIL) return -1;
+    if (!is_leaf(code->tree, code->tree->root)) build_decode_table(code->tree, code->decode_table);
+    return 0;
+}
+
+// Prepara a decodificação a partir de code->lengths. Retorna -1 se os comprimentos forem inválidos.
+static inline int block_code_prepare_decode(BlockCode *code) {
+    if (!valid_code_lengths(code->lengths)) return -1;
+    build_tree_from_lengths(code->lengths, block_code_tree(code));
+    return block_code_finish_tree(code);
+}
+
+static inline void block_code_free(BlockCode *code) {
+    free(code->tree);
+    free(code->decode_table);
+    code->tree = NULL;
+    code->decode_table = NULL;
+}
+
+/*
+    MODELO DE CONTEXTO (CONTAINER_FLAG_CONTEXT)
+
+    O byte anterior cai em uma de CONTEXT_CLASSES classes (controle/espaço,
+    letra/dígito, pontuação ASCII, byte alto). Cada bloco agrupa as classes em
+    1 a CONTEXT_CLASSES tabelas: começa com uma tabela por classe e junta, de
+    forma gulosa, o par cuja união mais reduz o tamanho estimado (bits codificados
+    + 256 bytes de comprimentos por tabela). Com uma única tabela o bloco é
+    codificado em ordem 0, como no modo normal.
+
+    Na decodificação cada tabela tem sua DecodeTable de vários símbolos, que para
+    no primeiro símbolo que leva a outra tabela; por isso o texto dentro de uma
+    mesma classe continua saindo até DECODE_MAX_SYMBOLS símbolos por consulta.
+*/
+
+#define CONTEXT_CLASSES 4
+#define CONTEXT_TABLE_BITS (256 * 8)    // custo de gravar os comprimentos de uma tabela
+
+// Classe de contexto de um byte: 0 = controle/espaço, 1 = letra ou dígito,
+// 2 = pontuação ASCII, 3 = byte alto (DEL e acima).
+static inline int byte_class(unsigned char c) {
+    if (c <= ' ') return 0;
+    if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) return 1;
+    if (c < 0x7F) return 2;
+    return 3;
+}
+
+typedef struct {
+    int n_tables;                           // 1 = ordem 0
+    uint8_t class_table[CONTEXT_CLASSES];   // classe do byte anterior -> tabela
+    uint8_t byte_table[256];                // byte anterior -> tabela (derivada de class_table)
+    BlockCode codes[CONTEXT_CLASSES];
+} ContextCode;
+
+static inline void context_code_set_classes(ContextCode *ctx) {
+    for (int c = 0; c < 256; c++) {
+        ctx->byte_table[c] = ctx->class_table[byte_class((unsigned char)c)];
+    }
+}
+
+static inline void context_code_free(ContextCode *ctx) {
+    if (!ctx) return;
+    for (int t = 0; t < CONTEXT_CLASSES; t++) block_code_free(&ctx->codes[t]);
+    free(ctx);
+}
+
+// Tamanho estimado, em bits, de codificar freq com uma tabela própria (0 sem símbolos).
+static inline uint64_t context_table_cost(const uint64_t freq[256], int max_code_length) {
+    uint8_t lengths[256];
+    uint64_t bits = 0;
+    int symbols = 0;
+
+    compute_code_lengths(freq, max_code_length, lengths);
+    for (int c = 0; c < 256; c++) {
+        bits += freq[c] * lengths[c];
+        symbols += freq[c] > 0;
+    }
+    if (symbols == 0) return 0;
+    if (symbols == 1) bits = 0;   // símbolo único: nenhum bit é emitido
+    return bits + CONTEXT_TABLE_BITS;
+}
+
+// Escolhe as tabelas do bloco a partir dos histogramas por classe do byte anterior.
+static inline void context_code_build(ContextCode *ctx, const unsigned char *data, size_t size, int max_code_length) {
+    uint64_t freq[CONTEXT_CLASSES][256];
+    uint8_t class_of[256];
+    memset(freq, 0, sizeof(freq));
+    for (int c = 0; c < 256; c++) class_of[c] = (uint8_t)byte_class((unsigned char)c);
+
+    unsigned char prev = 0;
+    for (size_t i = 0; i < size; i++) {
+        freq[class_of[prev]][data[i]]++;
+        prev = data[i];
+    }
+
+    // Cada grupo começa com uma classe; grupos vazios nunca são usados como contexto.
+    uint64_t cost[CONTEXT_CLASSES];
+    int group[CONTEXT_CLASSES], alive[CONTEXT_CLASSES];
+    for (int g = 0; g < CONTEXT_CLASSES; g++) {
+        group[g] = g;
+        cost[g] = context_table_cost(freq[g], max_code_length);
+        alive[g] = cost[g] > 0;
+    }
+
+    // Junta o par que mais reduz o custo total, enquanto alguma junção compensar.
+    for (;;) {
+        int best_a = -1, best_b = -1;
+        uint64_t best_gain = 0, best_cost = 0;
+        for (int a = 0; a < CONTEXT_CLASSES; a++) {
+            for (int b = a + 1; b < CONTEXT_CLASSES; b++) {
+                if (!alive[a] || !alive[b]) continue;
+
+                uint64_t merged[256];
+                for (int c = 0; c < 256; c++) merged[c] = freq[a][c] + freq[b][c];
+                uint64_t merged_cost = context_table_cost(merged, max_code_length);
+                if (merged_cost < cost[a] + cost[b] && cost[a] + cost[b] - merged_cost > best_gain) {
+                    best_gain = cost[a] + cost[b] - merged_cost;
+                    best_cost = merged_cost;
+                    best_a = a;
+                    best_b = b;
+                }
+            }
+        }
+        if (best_a < 0) break;
+
+        for (int c = 0; c < 256; c++) freq[best_a][c] += freq[best_b][c];
+        cost[best_a] = best_cost;
+        alive[best_b] = 0;
+        for (int g = 0; g < CONTEXT_CLASSES; g++) {
+            if (group[g] == best_b) group[g] = best_a;
+        }
+    }
+
+    // Numera as tabelas restantes; classes sem ocorrências usam a tabela 0.
+    int table_of[CONTEXT_CLASSES];
+    ctx->n_tables = 0;
+    for (int g = 0; g < CONTEXT_CLASSES; g++) {
+        if (alive[g]) {
+            table_of[g] = ctx->n_tables;
+            block_code_from_freq(&ctx->codes[ctx->n_tables++], freq[g], max_code_length);
+        }
+    }
+    if (ctx->n_tables == 0) {
+        uint64_t empty[256] = {0};
+        block_code_from_freq(&ctx->codes[ctx->n_tables++], empty, max_code_length);
+    }
+    for (int k = 0; k < CONTEXT_CLASSES; k++) {
+        ctx->class_table[k] = alive[group[k]] ? (uint8_t)table_of[group[k]] : 0;
+    }
+    context_code_set_classes(ctx);
+}
+
+// Codifica um bloco escolhendo a tabela pelo byte anterior.
+static inline size_t encode_block_context(const unsigned char *data, size_t size, const ContextCode *ctx, unsigned char *out) {
+    uint64_t acc = 0;
+    int bits = 0;
+    size_t used = 0;
+    unsigned char prev = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        HuffmanCode code = ctx->codes[ctx->byte_table[prev]].huff_table[data[i]];
+        prev = data[i];
+        acc = (acc << code.length) | code.code;
+        bits += code.length;
+
+        if (bits >= 32) {
+            out[used++] = (unsigned char)(acc >> (bits - 8));
+            out[used++] = (unsigned char)(acc >> (bits - 16));
+            out[used++] = (unsigned char)(acc >> (bits - 24));
+            out[used++] = (unsigned char)(acc >> (bits - 32));
+            bits -= 32;
+        }
+    }
+
+    while (bits >= 8) {
+        out[used++] = (unsigned char)(acc >> (bits - 8));
+        bits -= 8;
+    }
+    if (bits > 0) {
+        out[used++] = (unsigned char)(acc << (8 - bits));
+    }
+
+    return used;
+}
+
+// Aplica o número de tabelas e o mapa de classes (2 bits por classe) lidos de um bloco.
+// Retorna -1 se forem inválidos.
+static inline int context_code_set_header(ContextCode *ctx, int n_tables, uint8_t classes) {
+    if (n_tables < 1 || n_tables > CONTEXT_CLASSES) return -1;
+
+    ctx->n_tables = n_tables;
+    for (int k = 0; k < CONTEXT_CLASSES; k++) {
+        ctx->class_table[k] = (classes >> (2 * k)) & 3;
+        if (ctx->class_table[k] >= n_tables) return -1;
+    }
+    return 0;
+}
+
+// Prepara árvores e tabelas de decodificação de ctx->codes[*].lengths.
+// Retorna -1 se alguma tabela for inválida.
+static inline int context_code_prepare_decode(ContextCode *ctx) {
+    context_code_set_classes(ctx);
+    for (int t = 0; t < ctx->n_tables; t++) {
+        BlockCode *code = &ctx->codes[t];
+        if (!valid_code_lengths(code->lengths)) return -1;
+        build_tree_from_lengths(code->lengths, block_code_tree(code));
+        if (code->tree->root == TREE_NIL) return -1;
+        if (!is_leaf(code->tree, code->tree->root)) {
+            build_decode_table_for(code->tree, code->decode_table, ctx->byte_table, t);
+        }
+    }
+    return 0;
+}
+
+// Decodifica exatamente raw_len símbolos de um bloco com modelo de contexto.
+// Retorna quantos símbolos foram produzidos (menos que raw_len se o bloco acabar antes).
+static inline size_t decode_block_context(const ContextCode *ctx, const unsigned char *in, size_t in_len,
+                                   unsigned char *out, size_t raw_len) {
+    uint64_t acc = 0;
+    int bits = 0;
+    size_t pos = 0, produced = 0;
+    int table = ctx->byte_table[0];
+
+    while (produced < raw_len) {
+        while (bits <= 56 && pos < in_len) {
+            acc |= (uint64_t)in[pos++] << (56 - bits);
+            bits += 8;
+        }
+
+        const HUFF_TREE *tree = ctx->codes[table].tree;
+        const NODE *nodes = tree->nodes;
+        uint16_t current = tree->root;
+
+        if (!is_leaf(tree, current)) {
+            if (bits >= DECODE_TABLE_BITS && produced + DECODE_MAX_SYMBOLS <= raw_len) {
+                const DecodeEntry *entry = &ctx->codes[table].decode_table->entries[acc >> (64 - DECODE_TABLE_BITS)];
+                acc <<= entry->bits;
+                bits -= entry->bits;
+
+                if (entry->count > 0) {
+                    memcpy(out + produced, entry->symbols, DECODE_MAX_SYMBOLS);
+                    produced += entry->count;
+                    table = ctx->byte_table[out[produced - 1]];
+                    continue;
+                }
+                current = entry->node;
+            }
+
+            // Códigos longos e o final do bloco seguem a árvore bit a bit.
+            while (!is_leaf(tree, current)) {
+                if (bits == 0) {
+                    if (pos == in_len) return produced;
+                    acc = (uint64_t)in[pos++] << 56;
+                    bits = 8;
+                }
+                current = (acc >> 63) ? nodes[current].right : nodes[current].left;
+                acc <<= 1;
+                bits--;
+            }
+        }
+
+        // Tabela de um único símbolo: nenhum bit é consumido.
+        out[produced] = nodes[current].character;
+        table = ctx->byte_table[out[produced++]];
+    }
+
+    return produced;
+}
+
+
+// Um bloco da entrada e seus resultados em cada etapa.
+typedef struct {
+    unsigned char *data;
+    size_t raw_len;
+    uint64_t freq[256];
+    unsigned char *payload;
+    size_t payload_len, payload_cap;
+    BlockCode code;          // tabela própria do bloco (CONTAINER_FLAG_BLOCK_TABLES)
+    ContextCode *context;    // tabelas por contexto (CONTAINER_FLAG_CONTEXT), alocadas sob demanda
+    int flags;               // flags do contêiner de onde o bloco foi lido (0 na compactação)
+    uint32_t checksum;       // CRC32C gravado no bloco (CONTAINER_FLAG_CHECKSUM)
+    int status;              // 0 = ok, -1 = bloco inválido
+} HuffChunk;
+
+// Tabelas de contexto do bloco, alocadas no primeiro uso e reaproveitadas.
+static inline ContextCode* chunk_context(HuffChunk *chunk) {
+    if (!chunk->context) chunk->context = calloc(1, sizeof(ContextCode));
+    return chunk->context;
+}
+
+// CRC32C do bloco na ordem em que ele é gravado: tamanhos, tabelas e bits codificados.
+static inline uint32_t block_checksum(int flags, const HuffChunk *chunk) {
+    unsigned char sizes[8];
+    for (int k = 0; k < 4; k++) {
+        sizes[k] = (uint32_t)chunk->raw_len >> (8 * k);
+        sizes[4 + k] = (uint32_t)chunk->payload_len >> (8 * k);
+    }
+    uint32_t crc = crc32c_update(0, sizes, 8);
+
+    if (flags & CONTAINER_FLAG_CONTEXT) {
+        const ContextCode *ctx = chunk->context;
+        unsigned char head[2] = {(unsigned char)ctx->n_tables, 0};
+        for (int k = 0; k < CONTEXT_CLASSES; k++) head[1] |= ctx->class_table[k] << (2 * k);
+        crc = crc32c_update(crc, head, 2);
+        for (int t = 0; t < ctx->n_tables; t++) crc = crc32c_update(crc, ctx->codes[t].lengths, 256);
+    } else if (flags & CONTAINER_FLAG_BLOCK_TABLES) {
+        crc = crc32c_update(crc, chunk->code.lengths, 256);
+    }
+
+    return crc32c_update(crc, chunk->payload, chunk->payload_len);
+}
+
+// Bytes que o bloco ocupa no arquivo, do tamanho original até o checksum.
+static inline uint64_t block_stored_size(int flags, const HuffChunk *chunk) {
+    uint64_t size = 8 + chunk->payload_len;
+    if (flags & CONTAINER_FLAG_CONTEXT) size += 2 + 256 * (uint64_t)chunk->context->n_tables;
+    else if (flags & CONTAINER_FLAG_BLOCK_TABLES) size += 256;
+    if (flags & CONTAINER_FLAG_CHECKSUM) size += 4;
+    return size;
+}
+
+// Confere o CRC32C de um bloco lido; blocos de versões sem checksum sempre passam.
+static inline int chunk_checksum_ok(const HuffChunk *chunk) {
+    return !(chunk->flags & CONTAINER_FLAG_CHECKSUM) || block_checksum(chunk->flags, chunk) == chunk->checksum;
+}
+
+static inline void free_chunks(HuffChunk *chunks, size_t count) {
+    if (!chunks) return;
+    for (size_t i = 0; i < count; i++) {
+        free(chunks[i].payload);
+        block_code_free(&chunks[i].code);
+        context_code_free(chunks[i].context);
+    }
+    free(chunks);
+}
+
+// Decodifica os primeiros "need" bytes do bloco lido em chunk->payload para chunk->data.
+// shared é a tabela do arquivo ou NULL quando o bloco traz a própria tabela.
+static inline int decode_chunk(HuffChunk *chunk, BlockCode *shared, size_t need) {
+    if (!chunk_checksum_ok(chunk)) return -1;
+
+    BlockCode *code = shared;
+    if (chunk->context) {
+        ContextCode *ctx = chunk->context;
+        if (context_code_prepare_decode(ctx) != 0) return -1;
+        if (ctx->n_tables > 1) {
+            size_t produced = decode_block_context(ctx, chunk->payload, chunk->payload_len, chunk->data, need);
+            return produced == need ? 0 : -1;
+        }
+        code = &ctx->codes[0];   // uma tabela só: decodificador de ordem 0
+    } else if (!code) {
+        code = &chunk->code;
+        if (block_code_prepare_decode(code) != 0) return -1;
+    }
+
+    size_t produced = decode_block(code->decode_table, code->tree, chunk->payload, chunk->payload_len,
+                                   chunk->data, need);
+    return produced == need ? 0 : -1;
+}
+
+enum { STAGE_COUNT, STAGE_ENCODE, STAGE_ENCODE_CONTEXT, STAGE_DECODE, STAGE_VERIFY };
+
+typedef struct {
+    HuffChunk *chunks;
+    size_t count;
+    int tid, threads, stage;
+    BlockCode *shared;       // NULL: cada bloco usa (ou calcula) a própria tabela
+    int max_code_length;
+} WorkerArgs;
+
+// Cada thread processa os blocos tid, tid + threads, tid + 2 * threads, ...
+static inline void* chunk_worker(void *arg) {
+    WorkerArgs *args = arg;
+
+    for (size_t i = args->tid; i < args->count; i += args->threads) {
+        HuffChunk *chunk = &args->chunks[i];
+
+        if (args->stage == STAGE_COUNT) {
+            memset(chunk->freq, 0, sizeof(chunk->freq));
+            count_frequencies(chunk->data, chunk->raw_len, chunk->freq);
+        } else if (args->stage == STAGE_ENCODE) {
+            BlockCode *code = args->shared;
+            if (!code) {
+                code = &chunk->code;
+                memset(chunk->freq, 0, sizeof(chunk->freq));
+                count_frequencies(chunk->data, chunk->raw_len, chunk->freq);
+                block_code_from_freq(code, chunk->freq, args->max_code_length);
+            }
+            chunk->payload_len = encode_block(chunk->data, chunk->raw_len, code->huff_table, chunk->payload);
+        } else if (args->stage == STAGE_ENCODE_CONTEXT) {
+            ContextCode *ctx = chunk_context(chunk);
+            context_code_build(ctx, chunk->data, chunk->raw_len, args->max_code_length);
+            chunk->payload_len = encode_block_context(chunk->data, chunk->raw_len, ctx, chunk->payload);
+        } else if (args->stage == STAGE_VERIFY) {
+            chunk->status = chunk_checksum_ok(chunk) ? 0 : -1;
+        } else {
+            chunk->status = decode_chunk(chunk, args->shared, chunk->raw_len);
+        }
+    }
+
+    return NULL;
+}
+
+// Executa uma etapa sobre os blocos da rodada, com até "threads" threads.
+static inline void run_stage(HuffChunk *chunks, size_t count, int threads, int stage, BlockCode *shared, int max_code_length) {
+    if (threads > (int)count) threads = (int)count;
+    if (threads < 1) return;
+
+    pthread_t ids[threads];
+    WorkerArgs args[threads];
+    char started[threads];
+
+    // Se uma thread não puder ser criada, a parte dela roda aqui mesmo, depois da 0.
+    for (int t = 0; t < threads; t++) {
+        args[t] = (WorkerArgs){chunks, count, t, threads, stage, shared, max_code_length};
+        started[t] = t > 0 && pthread_create(&ids[t], NULL, chunk_worker, &args[t]) == 0;
+    }
+    for (int t = 0; t < threads; t++) {
+        if (!started[t]) chunk_worker(&args[t]);
+    }
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(ids[t], NULL);
+    }
+}
+
+// Número de núcleos disponíveis, usado quando o usuário pede 0 threads.
+static inline int default_threads() {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Origem dos blocos: a entrada inteira em memória ou leituras por rodada do arquivo.
+typedef struct {
+    FILE *file;
+    unsigned char *data;
+    size_t size, pos;
+    unsigned char *buffer;
+} ChunkSource;
+
+// Prepara a próxima rodada com até max_chunks blocos. Retorna quantos foram lidos.
+static inline size_t next_round(ChunkSource *src, HuffChunk *chunks, size_t max_chunks, uint32_t block_size) {
+    size_t count = 0;
+
+    while (count < max_chunks) {
+        size_t len;
+        if (src->data) {
+            len = src->size - src->pos;
+            if (len > block_size) len = block_size;
+            chunks[count].data = src->data + src->pos;
+            src->pos += len;
+        } else {
+            chunks[count].data = src->buffer + count * (size_t)block_size;
+            len = fread(chunks[count].data, 1, block_size, src->file);
+        }
+
+        if (len == 0) break;
+        chunks[count++].raw_len = len;
+    }
+
+    return count;
+}
+
+// CRC32C dos campos do cabeçalho, na ordem em que são gravados (lengths = NULL com tabelas por bloco).
+static inline uint32_t header_checksum(int version, int flags, uint32_t block_size, const uint8_t *lengths) {
+    unsigned char head[10];
+    memcpy(head, CONTAINER_MAGIC, 4);
+    head[4] = (unsigned char)version;
+    head[5] = (unsigned char)flags;
+    for (int k = 0; k < 4; k++) head[6 + k] = block_size >> (8 * k);
+
+    uint32_t crc = crc32c_update(0, head, 10);
+    return lengths ? crc32c_update(crc, lengths, 256) : crc;
+}
+
+// Grava um bloco codificado. Retorna o número de bytes escritos.
+static inline uint64_t write_block(FILE *output, int flags, const HuffChunk *chunk) {
+    write_u32(output, (uint32_t)chunk->raw_len);
+    write_u32(output, (uint32_t)chunk->payload_len);
+
+    if (flags & CONTAINER_FLAG_CONTEXT) {
+        // número de tabelas (u8) | tabela de cada classe, 2 bits por classe (u8) | comprimentos
+        const ContextCode *ctx = chunk->context;
+        uint8_t classes = 0;
+        for (int k = 0; k < CONTEXT_CLASSES; k++) classes |= ctx->class_table[k] << (2 * k);
+        fputc(ctx->n_tables, output);
+        fputc(classes, output);
+        for (int t = 0; t < ctx->n_tables; t++) fwrite(ctx->codes[t].lengths, 1, 256, output);
+    } else if (flags & CONTAINER_FLAG_BLOCK_TABLES) {
+        fwrite(chunk->code.lengths, 1, 256, output);
+    }
+
+    fwrite(chunk->payload, 1, chunk->payload_len, output);
+    if (flags & CONTAINER_FLAG_CHECKSUM) write_u32(output, block_checksum(flags, chunk));
+    return block_stored_size(flags, chunk);
+}
+
+// A entrada vem de src: dados em memória (src->data) ou um arquivo lido por rodadas.
+static inline int container_compress_source(ChunkSource *src, FILE *output, int threads, uint32_t block_size,
+                                     int max_code_length, int flags) {
+    // O modelo de contexto sempre usa tabelas por bloco.
+    if (flags & CONTAINER_FLAG_CONTEXT) flags |= CONTAINER_FLAG_BLOCK_TABLES;
+    flags |= CONTAINER_FLAG_CHECKSUM;
+    int block_tables = (flags & CONTAINER_FLAG_BLOCK_TABLES) != 0;
+    int encode_stage = (flags & CONTAINER_FLAG_CONTEXT) ? STAGE_ENCODE_CONTEXT : STAGE_ENCODE;
+    FILE *input = src->file;
+    if (max_code_length <= 0) max_code_length = DEFAULT_MAX_CODE_LENGTH;
+    if (max_code_length < MIN_CODE_LENGTH) max_code_length = MIN_CODE_LENGTH;
+    if (max_code_length > MAX_CODE_LENGTH) max_code_length = MAX_CODE_LENGTH;
+
+    if (block_size > MAX_BLOCK_SIZE) {
+        fprintf(stderr, "Erro: tamanho de bloco acima de %u bytes\n", MAX_BLOCK_SIZE);
+        return -1;
+    }
+
+    // Com a entrada em memória, uma rodada nunca precisa de mais blocos do que ela tem.
+    size_t round_chunks = (size_t)threads * CHUNKS_PER_THREAD;
+    if (src->data && src->size / block_size + 1 < round_chunks) round_chunks = src->size / block_size + 1;
+    size_t payload_cap = ((size_t)block_size * max_code_length + 7) / 8 + 8;
+    HuffChunk *chunks = calloc(round_chunks, sizeof(HuffChunk));
+    int allocated = chunks != NULL;
+    if (allocated && !src->data) {
+        src->buffer = malloc(round_chunks * block_size);
+        allocated = src->buffer != NULL;
+    }
+    for (size_t i = 0; allocated && i < round_chunks; i++) {
+        chunks[i].payload = malloc(payload_cap);
+        chunks[i].payload_cap = payload_cap;
+        allocated = chunks[i].payload != NULL;
+    }
+    if (!allocated) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        free_chunks(chunks, round_chunks);
+        free(src->buffer);
+        src->buffer = NULL;
+        return -1;
+    }
+
+    BlockCode shared = {0};
+    size_t count;
+    if (!block_tables) {
+        // Fase 1: histogramas por bloco em paralelo, somados a cada rodada.
+        uint64_t freq[256] = {0};
+        while ((count = next_round(src, chunks, round_chunks, block_size)) > 0) {
+            run_stage(chunks, count, threads, STAGE_COUNT, NULL, 0);
+            for (size_t i = 0; i < count; i++) {
+                for (int c = 0; c < 256; c++) freq[c] += chunks[i].freq[c];
+            }
+        }
+        block_code_from_freq(&shared, freq, max_code_length);
+
+        src->pos = 0;
+        if (!src->data) rewind(input);
+    }
+
+    fwrite(CONTAINER_MAGIC, 1, 4, output);
+    fputc(CONTAINER_VERSION, output);
+    fputc(flags, output);
+    write_u32(output, block_size);
+    uint64_t offset = 4 + 1 + 1 + 4;
+    if (!block_tables) {
+        fwrite(shared.lengths, 1, 256, output);
+        offset += 256;
+    }
+    write_u32(output, header_checksum(CONTAINER_VERSION, flags, block_size, block_tables ? NULL : shared.lengths));
+    offset += 4;
+
+    // Fase 2: codificação paralela; os blocos são gravados em ordem assim que a rodada termina.
+    size_t n_blocks = 0, index_cap = 1024;
+    uint64_t *index = malloc(index_cap * sizeof(uint64_t));
+    uint64_t total_size = 0;
+
+    while ((count = next_round(src, chunks, round_chunks, block_size)) > 0) {
+        run_stage(chunks, count, threads, encode_stage, block_tables ? NULL : &shared, max_code_length);
+
+        for (size_t i = 0; i < count; i++) {
+            if (n_blocks == index_cap) {
+                index_cap *= 2;
+                index = realloc(index, index_cap * sizeof(uint64_t));
+            }
+            index[n_blocks++] = offset;
+            offset += write_block(output, flags, &chunks[i]);
+            total_size += chunks[i].raw_len;
+        }
+    }
+
+    write_u32(output, 0);
+    offset += 4;
+
+    write_u64(output, n_blocks);
+    for (size_t i = 0; i < n_blocks; i++) {
+        write_u64(output, index[i]);
+    }
+    write_u64(output, total_size);
+    write_u64(output, offset);
+    fwrite(CONTAINER_FOOTER_MAGIC, 1, 4, output);
+    fflush(output);
+
+    free_chunks(chunks, round_chunks);
+    free(index);
+    free(src->buffer);
+    src->buffer = NULL;
+
+    return ferror(output) ? -1 : 0;
+}
+
+// Compacta a entrada no formato em blocos usando "threads" threads (0 = todos os núcleos),
+// com códigos de no máximo max_code_length bits.
+// Com CONTAINER_FLAG_BLOCK_TABLES (ou entrada sem seek, como um pipe) cada bloco tem a
+// própria tabela: a entrada é lida uma única vez, em rodadas de tamanho fixo.
+static inline int container_compress(FILE *input, FILE *output, int threads, uint32_t block_size,
+                              int max_code_length, int flags) {
+    if (threads <= 0) threads = default_threads();
+    if (block_size == 0) block_size = DEFAULT_BLOCK_SIZE;
+    if (fseek(input, 0, SEEK_CUR) != 0) flags |= CONTAINER_FLAG_BLOCK_TABLES;
+
+    ChunkSource src = {input, NULL, 0, 0, NULL};
+    if (!(flags & CONTAINER_FLAG_BLOCK_TABLES)) {
+        src.data = load_input(input, &src.size);
+    }
+
+    int status = container_compress_source(&src, output, threads, block_size, max_code_length, flags);
+    free(src.data);
+    return status;
+}
+
+// Compacta um buffer que já está em memória, sem copiá-lo.
+static inline int container_compress_buffer(const unsigned char *data, size_t size, FILE *output, int threads,
+                                     uint32_t block_size, int max_code_length, int flags) {
+    if (threads <= 0) threads = default_threads();
+    if (block_size == 0) block_size = DEFAULT_BLOCK_SIZE;
+
+    ChunkSource src = {NULL, (unsigned char *)data, size, 0, NULL};
+    return container_compress_source(&src, output, threads, block_size, max_code_length, flags);
+}
+
+// Campos do cabeçalho do contêiner; "code" só é usado sem CONTAINER_FLAG_BLOCK_TABLES.
+typedef struct {
+    int version;
+    int flags;
+    uint32_t block_size;
+    BlockCode code;
+} ContainerHeader;
+
+// Lê o cabeçalho e prepara a tabela compartilhada. Retorna 0 se o cabeçalho for válido.
+static inline int read_container_header(FILE *input, ContainerHeader *header) {
+    char magic[4];
+    memset(header, 0, sizeof(*header));
+
+    if (fread(magic, 1, 4, input) != 4 || memcmp(magic, CONTAINER_MAGIC, 4) != 0 ||
+        (header->version = fgetc(input)) < CONTAINER_VERSION_TREE || header->version > CONTAINER_VERSION ||
+        (header->version >= CONTAINER_VERSION_FLAGS && (header->flags = fgetc(input)) == EOF) ||
+        !read_u32(input, &header->block_size) || header->block_size == 0 || header->block_size > MAX_BLOCK_SIZE ||
+        (header->flags & ~CONTAINER_KNOWN_FLAGS) ||
+        ((header->flags & CONTAINER_FLAG_CONTEXT) &&
+         (header->version < CONTAINER_VERSION_CONTEXT || !(header->flags & CONTAINER_FLAG_BLOCK_TABLES))) ||
+        ((header->flags & CONTAINER_FLAG_CHECKSUM) && header->version < CONTAINER_VERSION_CHECKSUM)) {
+        fprintf(stderr, "Erro: cabeçalho de contêiner inválido ou versão %d não suportada\n", header->version);
+        return -1;
+    }
+
+    if (header->version == CONTAINER_VERSION_TREE) {
+        int bytes_read = 0;
+        HUFF_TREE *tree = block_code_tree(&header->code);
+        tree->root = read_tree(tree, input, &bytes_read);
+        if (block_code_finish_tree(&header->code) != 0) {
+            fprintf(stderr, "Erro: árvore inválida no cabeçalho\n");
+            return -1;
+        }
+        return 0;
+    }
+
+    int block_tables = (header->flags & CONTAINER_FLAG_BLOCK_TABLES) != 0;
+    if (!block_tables && fread(header->code.lengths, 1, 256, input) != 256) {
+        fprintf(stderr, "Erro: cabeçalho de contêiner truncado\n");
+        return -1;
+    }
+
+    uint32_t checksum;
+    if ((header->flags & CONTAINER_FLAG_CHECKSUM) &&
+        (!read_u32(input, &checksum) ||
+         checksum != header_checksum(header->version, header->flags, header->block_size,
+                                     block_tables ? NULL : header->code.lengths))) {
+        fprintf(stderr, "Erro: checksum do cabeçalho não confere\n");
+        return -1;
+    }
+
+    if (!block_tables && block_code_prepare_decode(&header->code) != 0) {
+        fprintf(stderr, "Erro: comprimentos de código inválidos no cabeçalho\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Tabela que vale para todos os blocos, ou NULL se cada bloco trouxer a sua.
+static inline BlockCode* shared_code(ContainerHeader *header) {
+    return (header->flags & CONTAINER_FLAG_BLOCK_TABLES) ? NULL : &header->code;
+}
+
+// Lê o próximo bloco (tamanhos, tabela própria, bits codificados e checksum).
+// O checksum só é conferido depois, em decode_chunk ou na etapa STAGE_VERIFY.
+// Retorna 1 se leu um bloco, 0 no marcador de fim e -1 se o arquivo estiver truncado ou inválido.
+static inline int read_block(FILE *input, const ContainerHeader *header, HuffChunk *chunk) {
+    uint32_t raw_len, payload_len;
+
+    if (!read_u32(input, &raw_len)) return -1;
+    if (raw_len == 0) return 0;
+    if (raw_len > header->block_size || !read_u32(input, &payload_len)) return -1;
+
+    if (header->flags & CONTAINER_FLAG_CONTEXT) {
+        ContextCode *ctx = chunk_context(chunk);
+        int n_tables = fgetc(input), classes = fgetc(input);
+        if (classes == EOF || context_code_set_header(ctx, n_tables, (uint8_t)classes) != 0) return -1;
+        for (int t = 0; t < n_tables; t++) {
+            if (fread(ctx->codes[t].lengths, 1, 256, input) != 256) return -1;
+        }
+    } else if ((header->flags & CONTAINER_FLAG_BLOCK_TABLES) &&
+               fread(chunk->code.lengths, 1, 256, input) != 256) {
+        return -1;
+    }
+
+    // Nenhum código passa de MAX_CODE_LENGTH bits: um bloco maior que isso está corrompido.
+    if (payload_len > ((uint64_t)raw_len * MAX_CODE_LENGTH + 7) / 8 + 8) return -1;
+    if (payload_len > chunk->payload_cap) {
+        unsigned char *payload = realloc(chunk->payload, payload_len);
+        if (!payload) return -1;
+        chunk->payload = payload;
+        chunk->payload_cap = payload_len;
+    }
+    if (fread(chunk->payload, 1, payload_len, input) != payload_len) return -1;
+    if ((header->flags & CONTAINER_FLAG_CHECKSUM) && !read_u32(input, &chunk->checksum)) return -1;
+
+    chunk->raw_len = raw_len;
+    chunk->payload_len = payload_len;
+    chunk->flags = header->flags;
+    return 1;
+}
+
+// Descompacta um arquivo no formato em blocos, decodificando cada rodada em paralelo.
+// Lê a entrada só para frente e para no marcador de fim, então funciona com pipes.
+static inline int container_decompress(FILE *input, FILE *output, int threads) {
+    if (threads <= 0) threads = default_threads();
+
+    ContainerHeader header;
+    if (read_container_header(input, &header) != 0) {
+        block_code_free(&header.code);
+        return -1;
+    }
+
+    size_t round_chunks = (size_t)threads * CHUNKS_PER_THREAD;
+    HuffChunk *chunks = calloc(round_chunks, sizeof(HuffChunk));
+    unsigned char *buffer = malloc(round_chunks * header.block_size);
+    if (!chunks || !buffer) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        free_chunks(chunks, round_chunks);
+        free(buffer);
+        block_code_free(&header.code);
+        return -1;
+    }
+
+    int status = 0, done = 0;
+    while (!done && status == 0) {
+        size_t count = 0;
+
+        while (count < round_chunks) {
+            chunks[count].data = buffer + count * (size_t)header.block_size;
+            int result = read_block(input, &header, &chunks[count]);
+            if (result < 0) status = -1;
+            if (result == 0) done = 1;
+            if (result <= 0) break;
+            count++;
+        }
+
+        run_stage(chunks, count, threads, STAGE_DECODE, shared_code(&header), 0);
+        for (size_t i = 0; i < count && chunks[i].status == 0; i++) {
+            fwrite(chunks[i].data, 1, chunks[i].raw_len, output);
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (chunks[i].status != 0) status = -1;
+        }
+    }
+
+    if (status != 0) {
+        fprintf(stderr, "Erro: contêiner truncado ou corrompido\n");
+    }
+
+    free_chunks(chunks, round_chunks);
+    free(buffer);
+    block_code_free(&header.code);
+
+    return status;
+}
+
+// Confere se o índice e o rodapé lidos de input batem com os blocos encontrados.
+static inline int verify_index(FILE *input, const uint64_t *index, uint64_t n_blocks, uint64_t total_size,
+                        uint64_t index_offset) {
+    uint64_t value;
+    char magic[4];
+
+    if (!read_u64(input, &value) || value != n_blocks) return -1;
+    for (uint64_t i = 0; i < n_blocks; i++) {
+        if (!read_u64(input, &value) || value != index[i]) return -1;
+    }
+    if (!read_u64(input, &value) || value != total_size ||
+        !read_u64(input, &value) || value != index_offset ||
+        fread(magic, 1, 4, input) != 4 || memcmp(magic, CONTAINER_FOOTER_MAGIC, 4) != 0 ||
+        fgetc(input) != EOF) {
+        return -1;
+    }
+    return 0;
+}
+
+// Confere um contêiner sem gravar a saída: tamanhos e tabelas de cada bloco, índice e
+// rodapé. Blocos com CONTAINER_FLAG_CHECKSUM só têm o CRC32C recalculado, em paralelo;
+// os de versões anteriores não têm checksum e são decodificados para a conferência.
+// Lê a entrada só para frente, então funciona com pipes.
+static inline int container_verify(FILE *input, int threads) {
+    if (threads <= 0) threads = default_threads();
+
+    ContainerHeader header;
+    if (read_container_header(input, &header) != 0) {
+        block_code_free(&header.code);
+        return -1;
+    }
+
+    int checksums = (header.flags & CONTAINER_FLAG_CHECKSUM) != 0;
+    size_t round_chunks = (size_t)threads * CHUNKS_PER_THREAD;
+    HuffChunk *chunks = calloc(round_chunks, sizeof(HuffChunk));
+    unsigned char *buffer = checksums ? NULL : malloc(round_chunks * header.block_size);
+    if (!chunks || (!checksums && !buffer)) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        free_chunks(chunks, round_chunks);
+        free(buffer);
+        block_code_free(&header.code);
+        return -1;
+    }
+
+    // Posição do primeiro bloco; na versão 1 (árvore no cabeçalho, sem índice) ela não é usada.
+    uint64_t offset = 4 + 1 + (header.version >= CONTAINER_VERSION_FLAGS) + 4 +
+                      ((header.flags & CONTAINER_FLAG_BLOCK_TABLES) ? 0 : 256) +
+                      ((header.flags & CONTAINER_FLAG_CHECKSUM) ? 4 : 0);
+    uint64_t total_size = 0, n_blocks = 0, index_cap = 1024;
+    uint64_t *index = malloc(index_cap * sizeof(uint64_t));
+    size_t last_len = header.block_size;
+
+    int status = 0, done = 0;
+    while (!done && status == 0) {
+        size_t count = 0;
+
+        while (count < round_chunks) {
+            if (buffer) chunks[count].data = buffer + count * (size_t)header.block_size;
+            int result = read_block(input, &header, &chunks[count]);
+            // Só o último bloco pode ser menor que o tamanho do bloco.
+            if (result > 0 && last_len != header.block_size) result = -1;
+            if (result < 0) status = -1;
+            if (result == 0) done = 1;
+            if (result <= 0) break;
+
+            if (n_blocks == index_cap) {
+                index_cap *= 2;
+                index = realloc(index, index_cap * sizeof(uint64_t));
+            }
+            index[n_blocks++] = offset;
+            offset += block_stored_size(header.flags, &chunks[count]);
+            total_size += chunks[count].raw_len;
+            last_len = chunks[count].raw_len;
+            count++;
+        }
+
+        run_stage(chunks, count, threads, checksums ? STAGE_VERIFY : STAGE_DECODE, shared_code(&header), 0);
+        for (size_t i = 0; i < count; i++) {
+            if (chunks[i].status != 0) status = -1;
+        }
+    }
+
+    if (status == 0 && header.version > CONTAINER_VERSION_TREE) {
+        status = verify_index(input, index, n_blocks, total_size, offset + 4);
+    }
+    if (status != 0) {
+        fprintf(stderr, "Erro: contêiner truncado ou corrompido\n");
+    }
+
+    free_chunks(chunks, round_chunks);
+    free(buffer);
+    free(index);
+    block_code_free(&header.code);
+
+    return status;
+}
+
+/*
+    ACESSO ALEATÓRIO: leitura de um intervalo qualquer do arquivo original
+*/
+
+// Arquivo em blocos aberto para leitura, com o índice carregado e o último bloco em cache.
+typedef struct {
+    FILE *file;
+    ContainerHeader header;
+    uint64_t total_size;
+    uint64_t n_blocks;
+    uint64_t *index;
+    HuffChunk chunk;         // último bloco lido
+    uint64_t cached_block;   // bloco presente em chunk.data (UINT64_MAX = nenhum)
+    size_t cached_len;       // quantos bytes desse bloco já foram decodificados
+} HuffArchive;
+
+static inline void archive_close(HuffArchive *archive) {
+    if (!archive) return;
+    if (archive->file) fclose(archive->file);
+    free(archive->index);
+    free(archive->chunk.payload);
+    free(archive->chunk.data);
+    block_code_free(&archive->chunk.code);
+    context_code_free(archive->chunk.context);
+    block_code_free(&archive->header.code);
+    free(archive);
+}
+
+// Abre o arquivo e carrega cabeçalho, tabela e índice do rodapé. Retorna NULL em caso de erro.
+static inline HuffArchive* archive_open(const char *filename) {
+    HuffArchive *archive = calloc(1, sizeof(HuffArchive));
+    if (!archive) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        return NULL;
+    }
+    archive->cached_block = UINT64_MAX;
+
+    archive->file = fopen(filename, "rb");
+    if (!archive->file) {
+        perror("Erro ao abrir o arquivo compactado");
+        archive_close(archive);
+        return NULL;
+    }
+
+    FILE *file = archive->file;
+    if (read_container_header(file, &archive->header) != 0) {
+        archive_close(archive);
+        return NULL;
+    }
+    uint32_t block_size = archive->header.block_size;
+
+    // O rodapé não tem checksum: o índice precisa ocupar exatamente o espaço entre
+    // index_offset e o rodapé, e o número de blocos precisa bater com total_size.
+    char magic[4];
+    uint64_t index_offset = 0;
+    long file_size = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    uint64_t index_end = file_size >= CONTAINER_FOOTER_SIZE ? (uint64_t)file_size - CONTAINER_FOOTER_SIZE : 0;
+    if (file_size < CONTAINER_FOOTER_SIZE ||
+        fseek(file, -CONTAINER_FOOTER_SIZE, SEEK_END) != 0 ||
+        !read_u64(file, &archive->total_size) || !read_u64(file, &index_offset) ||
+        fread(magic, 1, 4, file) != 4 || memcmp(magic, CONTAINER_FOOTER_MAGIC, 4) != 0 ||
+        index_offset > index_end || index_end - index_offset < 8 || (index_end - index_offset - 8) % 8 != 0 ||
+        fseek(file, (long)index_offset, SEEK_SET) != 0 ||
+        !read_u64(file, &archive->n_blocks) ||
+        archive->n_blocks != (index_end - index_offset - 8) / 8 ||
+        archive->n_blocks != archive->total_size / block_size + (archive->total_size % block_size != 0)) {
+        fprintf(stderr, "Erro: índice do contêiner ausente ou corrompido\n");
+        archive_close(archive);
+        return NULL;
+    }
+
+    archive->index = malloc((archive->n_blocks + 1) * sizeof(uint64_t));
+    archive->chunk.data = malloc(block_size);
+    if (!archive->index || !archive->chunk.data) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        archive_close(archive);
+        return NULL;
+    }
+
+    for (uint64_t i = 0; i < archive->n_blocks; i++) {
+        if (!read_u64(file, &archive->index[i])) {
+            fprintf(stderr, "Erro: índice do contêiner truncado\n");
+            archive_close(archive);
+            return NULL;
+        }
+    }
+    return archive;
+}
+
+// Garante que os primeiros "need" bytes do bloco b estejam decodificados em archive->chunk.data.
+static inline int archive_load_block(HuffArchive *archive, uint64_t b, size_t need) {
+    if (archive->cached_block == b && archive->cached_len >= need) return 0;
+
+    HuffChunk *chunk = &archive->chunk;
+    if (fseek(archive->file, (long)archive->index[b], SEEK_SET) != 0 ||
+        read_block(archive->file, &archive->header, chunk) != 1 || need > chunk->raw_len) {
+        archive->cached_block = UINT64_MAX;
+        return -1;
+    }
+
+    // Na primeira leitura só o prefixo necessário é decodificado; se o mesmo bloco
+    // voltar a ser pedido além desse ponto (leitura sequencial), decodifica o bloco inteiro.
+    if (archive->cached_block == b) need = chunk->raw_len;
+    if (decode_chunk(chunk, shared_code(&archive->header), need) != 0) {
+        archive->cached_block = UINT64_MAX;
+        return -1;
+    }
+
+    archive->cached_block = b;
+    archive->cached_len = need;
+    return 0;
+}
+
+// Copia para "out" até "length" bytes do arquivo original a partir de "offset".
+// Retorna quantos bytes foram copiados (menos que length no fim do arquivo ou em erro).
+static inline size_t archive_read(HuffArchive *archive, uint64_t offset, unsigned char *out, size_t length) {
+    uint32_t block_size = archive->header.block_size;
+    size_t copied = 0;
+
+    while (copied < length && offset < archive->total_size) {
+        uint64_t b = offset / block_size;
+        size_t start = (size_t)(offset % block_size);
+        size_t end = start + (length - copied);
+        if (end > block_size) end = block_size;
+        if (offset - start + end > archive->total_size) end = (size_t)(archive->total_size - (offset - start));
+
+        if (archive_load_block(archive, b, end) != 0) {
+            fprintf(stderr, "Erro: bloco %llu corrompido\n", (unsigned long long)b);
+            break;
+        }
+
+        memcpy(out + copied, archive->chunk.data + start, end - start);
+        copied += end - start;
+        offset += end - start;
+    }
+
+    return copied;
+}
+
+// Verifica se o arquivo começa com a assinatura do contêiner em blocos.
+// A posição de leitura é restaurada, então o arquivo precisa permitir seek.
+static inline int is_container_file(FILE *file) {
+    char magic[4];
+    long position = ftell(file);
+    int found = fread(magic, 1, 4, file) == 4 && memcmp(magic, CONTAINER_MAGIC, 4) == 0;
+    fseek(file, position, SEEK_SET);
+    return found;
+}
+
+#endif // HUFF_CONTAINER_H
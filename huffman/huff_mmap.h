@@ -0,0 +1,267 @@
+#ifndef HUFF_MMAP_H
+#define HUFF_MMAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "huff_container.h"
+
+/*
+    E/S POR MAPEAMENTO DE MEMÓRIA (mmap) para arquivos regulares
+
+    Na compactação, os blocos apontam direto para o mapeamento da entrada: não há
+    fread nem cópia para um buffer intermediário. Na descompactação do formato em
+    blocos, o rodapé informa o tamanho original; o arquivo de saída é criado com
+    esse tamanho, mapeado, e cada thread decodifica seus blocos direto na posição
+    final (bloco b começa em b * tamanho do bloco). Os bits compactados também são
+    lidos do mapeamento da entrada, sem fread.
+
+    Pipes, arquivos vazios e contêineres sem índice (versão 1) continuam pelo
+    caminho com stdio.
+*/
+
+typedef struct {
+    unsigned char *data;
+    size_t size;
+} MappedFile;
+
+// Mapeia um arquivo regular não vazio para leitura. Retorna -1 se não for possível.
+static inline int map_input_file(int fd, MappedFile *map) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) return -1;
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) return -1;
+
+    posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    map->data = data;
+    map->size = (size_t)st.st_size;
+    return 0;
+}
+
+// Dimensiona o arquivo de saída e o mapeia para escrita.
+static inline int map_output_file(int fd, size_t size, MappedFile *map) {
+    map->data = NULL;
+    map->size = size;
+    if (ftruncate(fd, (off_t)size) != 0) return -1;
+    if (size == 0) return 0;
+
+    void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) return -1;
+
+    map->data = data;
+    return 0;
+}
+
+static inline void unmap_file(MappedFile *map) {
+    if (map->data) munmap(map->data, map->size);
+    map->data = NULL;
+}
+
+static inline uint32_t load_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline uint64_t load_u64(const unsigned char *p) {
+    return (uint64_t)load_u32(p) | (uint64_t)load_u32(p + 4) << 32;
+}
+
+// Aponta o bloco b para os dados da entrada mapeada e para sua posição na saída
+// (out pode ser NULL quando o bloco só vai ter o checksum conferido).
+// Confere os tamanhos contra o índice e o tamanho total. Retorna -1 se o bloco for inválido.
+static inline int map_block(const unsigned char *in, uint64_t data_end, const ContainerHeader *header,
+                     uint64_t offset, uint64_t b, uint64_t total_size, unsigned char *out, HuffChunk *chunk) {
+    uint64_t start = b * header->block_size;
+    uint64_t expected = total_size - start < header->block_size ? total_size - start : header->block_size;
+    uint64_t table_len = (header->flags & CONTAINER_FLAG_BLOCK_TABLES) ? 256 : 0;
+
+    if (offset > data_end || data_end - offset < 8 + table_len) return -1;
+    uint32_t raw_len = load_u32(in + offset);
+    uint32_t payload_len = load_u32(in + offset + 4);
+    const unsigned char *tables = in + offset + 8;
+
+    if (header->flags & CONTAINER_FLAG_CONTEXT) {
+        // número de tabelas | mapa de classes | n x 256 comprimentos
+        ContextCode *ctx = chunk_context(chunk);
+        if (context_code_set_header(ctx, tables[0], tables[1]) != 0) return -1;
+        table_len = 2 + 256 * (uint64_t)ctx->n_tables;
+        if (data_end - offset - 8 < table_len) return -1;
+        for (int t = 0; t < ctx->n_tables; t++) memcpy(ctx->codes[t].lengths, tables + 2 + 256 * t, 256);
+    } else if (table_len) {
+        memcpy(chunk->code.lengths, tables, 256);
+    }
+
+    uint64_t checksum_len = (header->flags & CONTAINER_FLAG_CHECKSUM) ? 4 : 0;
+    if (raw_len != expected || data_end - offset - 8 - table_len < payload_len ||
+        data_end - offset - 8 - table_len - payload_len < checksum_len) {
+        return -1;
+    }
+    chunk->payload = (unsigned char *)tables + table_len;
+    chunk->payload_len = payload_len;
+    if (checksum_len) chunk->checksum = load_u32(chunk->payload + payload_len);
+    chunk->flags = header->flags;
+    chunk->data = out ? out + start : NULL;
+    chunk->raw_len = raw_len;
+    return 0;
+}
+
+// Confere um contêiner mapeado sem gravar a saída: cada bloco tem de começar onde o
+// anterior termina e ter o CRC32C correto. Retorna 0 se estiver íntegro, -1 se estiver
+// corrompido e 1 se não for um contêiner com checksums (o chamador usa container_verify).
+static inline int container_verify_mapped(const unsigned char *in, size_t in_size, int threads) {
+    if (threads <= 0) threads = default_threads();
+    if (in_size < 4 + CONTAINER_FOOTER_SIZE || memcmp(in, CONTAINER_MAGIC, 4) != 0) return 1;
+
+    ContainerHeader header;
+    FILE *header_file = fmemopen((void *)in, in_size, "rb");
+    if (!header_file) return 1;
+    int header_status = read_container_header(header_file, &header);
+    long first_block = ftell(header_file);
+    fclose(header_file);
+    block_code_free(&header.code);
+    if (header_status != 0) return -1;
+    if (!(header.flags & CONTAINER_FLAG_CHECKSUM)) return 1;
+
+    uint64_t total_size = load_u64(in + in_size - CONTAINER_FOOTER_SIZE);
+    uint64_t index_offset = load_u64(in + in_size - CONTAINER_FOOTER_SIZE + 8);
+    uint64_t index_end = in_size - CONTAINER_FOOTER_SIZE;
+    uint64_t n_blocks = index_offset <= index_end && index_end - index_offset >= 8 ? load_u64(in + index_offset) : 0;
+    if (memcmp(in + in_size - 4, CONTAINER_FOOTER_MAGIC, 4) != 0 ||
+        index_offset > index_end || index_end - index_offset < 8 ||
+        (index_end - index_offset - 8) / 8 != n_blocks || (index_end - index_offset - 8) % 8 != 0 ||
+        n_blocks != total_size / header.block_size + (total_size % header.block_size != 0) ||
+        index_offset < 4 || load_u32(in + index_offset - 4) != 0) {
+        fprintf(stderr, "Erro: índice ou rodapé do contêiner corrompido\n");
+        return -1;
+    }
+    const unsigned char *index = in + index_offset + 8;
+
+    size_t round_chunks = (size_t)threads * CHUNKS_PER_THREAD;
+    HuffChunk *chunks = calloc(round_chunks, sizeof(HuffChunk));
+    uint64_t expected_offset = (uint64_t)first_block;
+    int status = 0;
+
+    for (uint64_t first = 0; first < n_blocks && status == 0; first += round_chunks) {
+        size_t count = n_blocks - first < round_chunks ? (size_t)(n_blocks - first) : round_chunks;
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t b = first + i;
+            uint64_t offset = load_u64(index + b * 8);
+            if (offset != expected_offset ||
+                map_block(in, index_offset - 4, &header, offset, b, total_size, NULL, &chunks[i]) != 0) {
+                status = -1;
+                count = i;
+                break;
+            }
+            expected_offset += block_stored_size(header.flags, &chunks[i]);
+        }
+
+        run_stage(chunks, count, threads, STAGE_VERIFY, NULL, 0);
+        for (size_t i = 0; i < count; i++) {
+            if (chunks[i].status != 0) status = -1;
+        }
+    }
+    if (status == 0 && expected_offset != index_offset - 4) status = -1;
+
+    if (status != 0) {
+        fprintf(stderr, "Erro: contêiner truncado ou corrompido\n");
+    }
+
+    for (size_t i = 0; i < round_chunks; i++) {
+        context_code_free(chunks[i].context);
+    }
+    free(chunks);
+    return status;
+}
+
+// Descompacta um contêiner mapeado em memória direto para output_path, também mapeado.
+// Retorna 0 em caso de sucesso, -1 em erro e 1 se a entrada não for um contêiner com
+// índice (nesse caso nada foi escrito e o chamador usa o caminho com stdio).
+static inline int container_decompress_mapped(const unsigned char *in, size_t in_size, const char *output_path,
+                                       int threads) {
+    if (threads <= 0) threads = default_threads();
+    if (in_size < 4 + CONTAINER_FOOTER_SIZE || memcmp(in, CONTAINER_MAGIC, 4) != 0 ||
+        memcmp(in + in_size - 4, CONTAINER_FOOTER_MAGIC, 4) != 0) {
+        return 1;
+    }
+
+    // O cabeçalho é lido pela mesma rotina do caminho com stdio, sobre o próprio mapeamento.
+    ContainerHeader header;
+    FILE *header_file = fmemopen((void *)in, in_size, "rb");
+    if (!header_file) return 1;
+    int header_status = read_container_header(header_file, &header);
+    fclose(header_file);
+    if (header_status != 0 || header.version == CONTAINER_VERSION_TREE) {
+        block_code_free(&header.code);
+        return header_status != 0 ? -1 : 1;
+    }
+
+    uint64_t total_size = load_u64(in + in_size - CONTAINER_FOOTER_SIZE);
+    uint64_t index_offset = load_u64(in + in_size - CONTAINER_FOOTER_SIZE + 8);
+    uint64_t index_end = in_size - CONTAINER_FOOTER_SIZE;
+    uint64_t n_blocks = index_offset <= index_end && index_end - index_offset >= 8 ? load_u64(in + index_offset) : 0;
+    if (index_offset > index_end || index_end - index_offset < 8 ||
+        n_blocks != total_size / header.block_size + (total_size % header.block_size != 0) ||
+        n_blocks > (index_end - index_offset - 8) / 8) {
+        fprintf(stderr, "Erro: índice do contêiner ausente ou corrompido\n");
+        block_code_free(&header.code);
+        return -1;
+    }
+    const unsigned char *index = in + index_offset + 8;
+
+    int fd = open(output_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    MappedFile out;
+    if (fd < 0 || map_output_file(fd, (size_t)total_size, &out) != 0) {
+        perror(output_path);
+        if (fd >= 0) close(fd);
+        block_code_free(&header.code);
+        return -1;
+    }
+
+    // Decodifica em rodadas para limitar as tabelas por bloco em memória.
+    size_t round_chunks = (size_t)threads * CHUNKS_PER_THREAD;
+    HuffChunk *chunks = calloc(round_chunks, sizeof(HuffChunk));
+    int status = 0;
+
+    for (uint64_t first = 0; first < n_blocks && status == 0; first += round_chunks) {
+        size_t count = n_blocks - first < round_chunks ? (size_t)(n_blocks - first) : round_chunks;
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t b = first + i;
+            if (map_block(in, index_offset, &header, load_u64(index + b * 8), b, total_size,
+                          out.data, &chunks[i]) != 0) {
+                status = -1;
+                count = i;
+                break;
+            }
+        }
+
+        run_stage(chunks, count, threads, STAGE_DECODE, shared_code(&header), 0);
+        for (size_t i = 0; i < count; i++) {
+            if (chunks[i].status != 0) status = -1;
+        }
+    }
+
+    if (status != 0) {
+        fprintf(stderr, "Erro: contêiner truncado ou corrompido\n");
+    }
+
+    // Os bits compactados pertencem ao mapeamento da entrada: só as tabelas são liberadas.
+    for (size_t i = 0; i < round_chunks; i++) {
+        block_code_free(&chunks[i].code);
+        context_code_free(chunks[i].context);
+    }
+    free(chunks);
+    block_code_free(&header.code);
+    unmap_file(&out);
+    if (close(fd) != 0) status = -1;
+
+    return status;
+}
+
+#endif // HUFF_MMAP_H
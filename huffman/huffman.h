@@ -9,36 +9,159 @@
 #include "pqueue_heap.h"
 
 #define BUFFER_SIZE 1024
+#define IO_BLOCK_SIZE (1 << 16)
+#define HISTOGRAM_TABLES 4
+
+// Soma as frequências de um bloco em memória usando tabelas intercaladas.
+// Bytes repetidos caem em tabelas diferentes, evitando dependência entre incrementos.
+static inline void count_frequencies(const unsigned char *data, size_t size, uint64_t freq[256]) {
+    uint64_t counts[HISTOGRAM_TABLES][256] = {{0}};
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        counts[0][(unsigned char)(word)]++;
+        counts[1][(unsigned char)(word >> 8)]++;
+        counts[2][(unsigned char)(word >> 16)]++;
+        counts[3][(unsigned char)(word >> 24)]++;
+        counts[0][(unsigned char)(word >> 32)]++;
+        counts[1][(unsigned char)(word >> 40)]++;
+        counts[2][(unsigned char)(word >> 48)]++;
+        counts[3][(unsigned char)(word >> 56)]++;
+    }
+    for (; i < size; i++) {
+        counts[0][data[i]]++;
+    }
 
-// Conta a frequência de cada caractere e preenche duas filas de prioridade.
-void create_huff_queue(FILE *input_file, PRIORITY_QUEUE** pq1, PRIORITY_QUEUE** pq2) {
-    int freq[256] = {0};
-    unsigned char c; 
-
-    while (fread(&c, 1, 1, input_file) == 1) { 
-        freq[c]++; 
+    for (int c = 0; c < 256; c++) {
+        for (int t = 0; t < HISTOGRAM_TABLES; t++) {
+            freq[c] += counts[t][c];
+        }
     }
+}
 
+// Cria na árvore uma folha para cada caractere presente e a insere na fila.
+static inline void create_huff_queue_from_freq(HUFF_TREE* tree, const uint64_t freq[256], PRIORITY_QUEUE** pq) {
     for (int i = 0; i < 256; i++) {
         if (freq[i] > 0) { 
-            NODE* node = create_node(i, freq[i], NULL, NULL); 
-            insert(*pq1, node); 
-            insert(*pq2, node); 
+            insert(*pq, create_node(tree, i, freq[i], TREE_NIL, TREE_NIL)); 
         }
     }
 }
 
+// Soma as frequências de todo o restante do arquivo, lendo em blocos.
+static inline void count_file_frequencies(FILE *input_file, uint64_t freq[256]) {
+    unsigned char *block = malloc(IO_BLOCK_SIZE);
+
+    size_t n;
+    while ((n = fread(block, 1, IO_BLOCK_SIZE, input_file)) > 0) {
+        count_frequencies(block, n, freq);
+    }
+    free(block);
+}
+
 // Constrói a árvore de Huffman a partir da fila de prioridade.
-NODE* build_huffman_tree(PRIORITY_QUEUE* pq) {
+// Retorna o índice da raiz (TREE_NIL se a fila estiver vazia).
+static inline uint16_t build_huffman_tree(HUFF_TREE* tree, PRIORITY_QUEUE* pq) {
     while (pq->size > 1) {
-        NODE* left = remove_lower(pq);
-        NODE* right = remove_lower(pq); 
+        uint16_t left = remove_lower(pq);
+        uint16_t right = remove_lower(pq); 
 
-        NODE* parent = create_node('\0', left->frequency + right->frequency, left, right);
-        insert(pq, parent);
+        uint64_t frequency = tree->nodes[left].frequency + tree->nodes[right].frequency;
+        insert(pq, create_node(tree, '\0', frequency, left, right));
     }
 
-    return remove_lower(pq);
+    tree->root = remove_lower(pq);
+    return tree->root;
+}
+
+// Ordena até 256 chaves "frequência << 8 | símbolo" com radix sort por byte. As chaves
+// chegam em ordem de símbolo e cada passada é estável, então o byte do símbolo não
+// precisa de passada; bytes iguais em todas as chaves (os altos, em geral) também não.
+static inline void sort_leaf_keys(uint64_t keys[256], int n) {
+    uint64_t buffer[256];
+    uint64_t *from = keys, *to = buffer;
+
+    for (int shift = 8; shift < 64; shift += 8) {
+        int count[256] = {0};
+        for (int i = 0; i < n; i++) count[(from[i] >> shift) & 0xFF]++;
+        if (count[(from[0] >> shift) & 0xFF] == n) continue;
+
+        int position = 0;
+        for (int d = 0; d < 256; d++) {
+            int c = count[d];
+            count[d] = position;
+            position += c;
+        }
+        for (int i = 0; i < n; i++) to[count[(from[i] >> shift) & 0xFF]++] = from[i];
+
+        uint64_t *swap_keys = from;
+        from = to;
+        to = swap_keys;
+    }
+
+    if (from != keys) memcpy(keys, from, n * sizeof(uint64_t));
+}
+
+// Constrói a árvore de Huffman em tempo linear depois de ordenar as folhas uma vez
+// (método das duas filas). As folhas ocupam as posições 0..n-1 em ordem crescente de
+// frequência e cada nó interno novo nunca é menor que o anterior, então os nós
+// n..count-1 já formam a segunda fila ordenada: o menor item está sempre na frente
+// de uma das duas. Em empate a folha vem primeiro, o que evita aprofundar a árvore.
+// Os filhos sempre têm índice menor que o pai. Retorna a raiz (TREE_NIL sem símbolos).
+static inline uint16_t build_huffman_tree_sorted(HUFF_TREE* tree, const uint64_t freq[256]) {
+    // Frequência e símbolo em uma única chave: ordena por frequência e, no empate, pelo símbolo.
+    uint64_t keys[256];
+    int n = 0;
+    for (int c = 0; c < 256; c++) {
+        if (freq[c] > 0) keys[n++] = freq[c] << 8 | (uint64_t)c;
+    }
+    if (n > 1) sort_leaf_keys(keys, n);
+
+    tree_reset(tree);
+    for (int i = 0; i < n; i++) {
+        create_node(tree, (unsigned char)keys[i], keys[i] >> 8, TREE_NIL, TREE_NIL);
+    }
+
+    const NODE* nodes = tree->nodes;
+    int leaf = 0, internal = n;
+    while (tree->count < 2 * n - 1) {
+        uint16_t pick[2];
+        for (int k = 0; k < 2; k++) {
+            if (internal == tree->count || (leaf < n && nodes[leaf].frequency <= nodes[internal].frequency)) {
+                pick[k] = (uint16_t)leaf++;
+            } else {
+                pick[k] = (uint16_t)internal++;
+            }
+        }
+        create_node(tree, '\0', nodes[pick[0]].frequency + nodes[pick[1]].frequency, pick[0], pick[1]);
+    }
+
+    tree->root = n > 0 ? (uint16_t)(tree->count - 1) : TREE_NIL;
+    return tree->root;
+}
+
+// Profundidade de cada folha de uma árvore de build_huffman_tree_sorted, sem recursão:
+// como todo pai vem depois dos filhos, basta percorrer o vetor de trás para frente.
+// Retorna a maior profundidade.
+static inline int sorted_tree_depths(const HUFF_TREE* tree, uint8_t lengths[256]) {
+    uint8_t depth[MAX_TREE_NODES];
+    int max_depth = 0;
+    memset(lengths, 0, 256);
+    if (tree->root == TREE_NIL) return 0;
+
+    depth[tree->root] = 0;
+    for (int i = tree->root; i >= 0; i--) {
+        const NODE* node = &tree->nodes[i];
+        if (node->left == TREE_NIL) {
+            lengths[node->character] = depth[i];
+            if (depth[i] > max_depth) max_depth = depth[i];
+        } else {
+            depth[node->left] = depth[node->right] = depth[i] + 1;
+        }
+    }
+    return max_depth;
 }
 
 // Struct para armazenar o código de Huffman e seu comprimento.
@@ -48,65 +171,64 @@ typedef struct {
 } HuffmanCode;
 
 // Gera a tabela de códigos de Huffman percorrendo a árvore.
-void create_huffman_table(NODE* root, uint32_t code, int depth, HuffmanCode huff_table[256]) {
-    if (!root) return;
+static inline void create_huffman_table(const HUFF_TREE* tree, uint16_t root, uint32_t code, int depth, HuffmanCode huff_table[256]) {
+    if (root == TREE_NIL) return;
+    const NODE* node = &tree->nodes[root];
 
-    if (!root->left && !root->right) {
-        huff_table[root->character].code = code;
-        huff_table[root->character].length = depth;
+    if (node->left == TREE_NIL && node->right == TREE_NIL) {
+        huff_table[node->character].code = code;
+        huff_table[node->character].length = depth;
         return;
     }
 
-    create_huffman_table(root->left, (code << 1), depth + 1, huff_table);
-    create_huffman_table(root->right, (code << 1) | 1, depth + 1, huff_table);
+    create_huffman_table(tree, node->left, (code << 1), depth + 1, huff_table);
+    create_huffman_table(tree, node->right, (code << 1) | 1, depth + 1, huff_table);
 }
 
-// Calcula o total de bits necessários para o arquivo compactado.
-int calculate_bits_trashed(PRIORITY_QUEUE* pq, HuffmanCode huff_table[256]) {
-    int bit_amount = 0;
-    while (pq->size > 0) {
-        NODE* node = remove_lower(pq); 
-        if (node && huff_table[node->character].length > 0) {
-            bit_amount += node->frequency * huff_table[node->character].length;
-        }
+// Calcula o total de bits necessários para o arquivo compactado (frequência x comprimento).
+static inline uint64_t calculate_bits_trashed(const uint64_t freq[256], HuffmanCode huff_table[256]) {
+    uint64_t bit_amount = 0;
+    for (int c = 0; c < 256; c++) {
+        bit_amount += freq[c] * (uint64_t)huff_table[c].length;
     }
 
     return bit_amount;
 }
 
 // Conta o número total de nós na árvore.
-int count_tree_size(NODE* root) {
-    if (!root) return 0;
-    return count_tree_size(root->left) + count_tree_size(root->right) + 1;
+static inline int count_tree_size(const HUFF_TREE* tree, uint16_t root) {
+    if (root == TREE_NIL) return 0;
+    return count_tree_size(tree, tree->nodes[root].left) + count_tree_size(tree, tree->nodes[root].right) + 1;
 }
 
 // Verifica se um nó é uma folha.
-int is_leaf(NODE* node) {
-    return node && !node->left && !node->right;
+static inline int is_leaf(const HUFF_TREE* tree, uint16_t node) {
+    return node != TREE_NIL && tree->nodes[node].left == TREE_NIL && tree->nodes[node].right == TREE_NIL;
 } 
 
 // Escreve a estrutura da árvore no arquivo de saída (formato pré-ordem).
-void write_tree(NODE* root, FILE* output_file) {
-    if (is_leaf(root)) {
+static inline void write_tree(const HUFF_TREE* tree, uint16_t root, FILE* output_file) {
+    const NODE* node = &tree->nodes[root];
+    if (is_leaf(tree, root)) {
         fputc('1', output_file); 
 
-        if (root->character == '*' || root->character == '\\') {
+        if (node->character == '*' || node->character == '\\') {
             fputc('\\', output_file);
         }
-        fputc(root->character, output_file);
+        fputc(node->character, output_file);
     } else {
         fputc('0', output_file);
-        write_tree(root->left, output_file);
-        write_tree(root->right, output_file);
+        write_tree(tree, node->left, output_file);
+        write_tree(tree, node->right, output_file);
     }
 }
 
 // Escreve o cabeçalho do arquivo compactado (lixo, tamanho da árvore e a própria árvore).
-void write_header(PRIORITY_QUEUE* pq, HuffmanCode huff_table[256], FILE *output_file, NODE* root) {
+static inline void write_header(const uint64_t freq[256], HuffmanCode huff_table[256], FILE *output_file, const HUFF_TREE* tree) {
 
-    int total_bits = calculate_bits_trashed(pq, huff_table);
-    int trash = ((8 - (total_bits % 8)) % 8);
-    int tree_size = count_tree_size(root);
+    uint64_t total_bits = calculate_bits_trashed(freq, huff_table);
+    int trash = (int)((8 - (total_bits % 8)) % 8);
+    int tree_size = count_tree_size(tree, tree->root);
 
     unsigned short header = (trash << 13) | tree_size;
 
@@ -116,96 +238,321 @@ void write_header(PRIORITY_QUEUE* pq, HuffmanCode huff_table[256], FILE *output_
     fwrite(&byte1, 1, 1, output_file);
     fwrite(&byte2, 1, 1, output_file);
 
-    write_tree(root, output_file);
+    write_tree(tree, tree->root, output_file);
+}
+
+/*
+    CÓDIGOS CANÔNICOS COM COMPRIMENTO MÁXIMO
+*/
+
+#define MAX_CODE_LENGTH 32          // limite imposto por HuffmanCode.code (uint32_t)
+#define MIN_CODE_LENGTH 8           // 256 símbolos precisam de pelo menos 8 bits
+#define DEFAULT_MAX_CODE_LENGTH 15
+
+// Profundidade da folha mais funda; códigos acima de MAX_CODE_LENGTH não cabem na tabela.
+static inline int tree_depth(const HUFF_TREE* tree, uint16_t root) {
+    if (root == TREE_NIL || is_leaf(tree, root)) return 0;
+    int left = tree_depth(tree, tree->nodes[root].left);
+    int right = tree_depth(tree, tree->nodes[root].right);
+    return 1 + (left > right ? left : right);
 }
 
-// Struct para acumular bits até formar um byte completo.
+// Item do package-merge: uma folha (symbol >= 0) ou um pacote de dois itens do nível anterior.
 typedef struct {
-    unsigned char byte;
-    int bits_used;
-} BitBuffer;
+    uint64_t weight;
+    int symbol;
+    int left, right;
+} PackageItem;
+
+static inline int compare_package_items(const void *a, const void *b) {
+    const PackageItem *x = a, *y = b;
+    if (x->weight != y->weight) return x->weight < y->weight ? -1 : 1;
+    return x->symbol - y->symbol;
+}
 
-// Adiciona um único bit ao buffer.
-void bit_buffer_add(BitBuffer *bit_buffer, int bit) {
-    bit_buffer->byte <<= 1;
-    bit_buffer->byte |= (bit & 1);
-    bit_buffer->bits_used++;
+static inline void count_package_leaves(const PackageItem *pool, int item, uint8_t lengths[256]) {
+    if (pool[item].symbol >= 0) {
+        lengths[pool[item].symbol]++;
+        return;
+    }
+    count_package_leaves(pool, pool[item].left, lengths);
+    count_package_leaves(pool, pool[item].right, lengths);
 }
 
-// Escreve o byte acumulado no buffer para o arquivo.
-void write_buffer(FILE *f, BitBuffer *bit_buffer) { 
-    if (bit_buffer->bits_used == 0) return;
+// Calcula comprimentos de código ótimos limitados a max_length bits (package-merge).
+// Um único símbolo recebe comprimento 1 para continuar identificável no cabeçalho.
+static inline void compute_code_lengths(const uint64_t freq[256], int max_length, uint8_t lengths[256]) {
+    if (max_length > MAX_CODE_LENGTH) max_length = MAX_CODE_LENGTH;
+    if (max_length < MIN_CODE_LENGTH) max_length = MIN_CODE_LENGTH;
+    memset(lengths, 0, 256);
+
+    PackageItem leaves[256];
+    int n = 0;
+    for (int c = 0; c < 256; c++) {
+        if (freq[c] > 0) leaves[n++] = (PackageItem){freq[c], c, -1, -1};
+    }
+    if (n == 0) return;
+    if (n == 1) {
+        lengths[leaves[0].symbol] = 1;
+        return;
+    }
 
-    unsigned char temp_byte = bit_buffer->byte << (8 - bit_buffer->bits_used);
-    fwrite(&temp_byte, 1, 1, f);
+    // Se a árvore de Huffman comum já respeita o limite, seus comprimentos são ótimos
+    // e o package-merge (O(n * max_length)) é desnecessário.
+    HUFF_TREE tree;
+    build_huffman_tree_sorted(&tree, freq);
+    if (sorted_tree_depths(&tree, lengths) <= max_length) return;
+    memset(lengths, 0, 256);
+
+    qsort(leaves, n, sizeof(PackageItem), compare_package_items);
+
+    // Cada nível tem no máximo 2n - 1 itens; o pool guarda todos os níveis.
+    PackageItem *pool = malloc((size_t)max_length * 2 * n * sizeof(PackageItem));
+    memcpy(pool, leaves, n * sizeof(PackageItem));
+    int prev_start = 0, prev_count = n, used = n;
+
+    for (int level = 1; level < max_length; level++) {
+        int start = used;
+        int packages = prev_count / 2;
+        int li = 0, pi = 0;
+
+        // Intercala as folhas com os pacotes formados pelos pares do nível anterior.
+        while (li < n || pi < packages) {
+            uint64_t package_weight = 0;
+            if (pi < packages) {
+                package_weight = pool[prev_start + 2 * pi].weight + pool[prev_start + 2 * pi + 1].weight;
+            }
+            if (pi >= packages || (li < n && leaves[li].weight <= package_weight)) {
+                pool[used++] = leaves[li++];
+            } else {
+                pool[used++] = (PackageItem){package_weight, -1, prev_start + 2 * pi, prev_start + 2 * pi + 1};
+                pi++;
+            }
+        }
 
-    bit_buffer->byte = 0;   
-    bit_buffer->bits_used = 0;
+        prev_start = start;
+        prev_count = used - start;
+    }
+
+    for (int i = 0; i < 2 * n - 2; i++) {
+        count_package_leaves(pool, prev_start + i, lengths);
+    }
+    free(pool);
 }
 
-// Lê o arquivo original e o compacta bit a bit.
-void compactor(FILE *input_file, FILE *output_file, HuffmanCode huff_table[256]) {
-    unsigned char c;
-    BitBuffer bit_buffer = {0, 0}; 
+// Atribui códigos canônicos: por comprimento e, dentro dele, pela ordem dos símbolos.
+// Com um único símbolo nenhum bit é emitido (o decodificador repete o símbolo).
+static inline void assign_canonical_codes(const uint8_t lengths[256], HuffmanCode huff_table[256]) {
+    int count[MAX_CODE_LENGTH + 1] = {0};
+    int symbols = 0;
+    for (int c = 0; c < 256; c++) {
+        if (lengths[c] > 0) {
+            count[lengths[c]]++;
+            symbols++;
+        }
+    }
 
-    while (fread(&c, 1, 1, input_file) == 1) {
-        HuffmanCode code = huff_table[c];
+    uint32_t next_code[MAX_CODE_LENGTH + 2] = {0};
+    uint64_t code = 0;
+    for (int len = 1; len <= MAX_CODE_LENGTH; len++) {
+        code = (code + count[len - 1]) << 1;
+        next_code[len] = (uint32_t)code;
+    }
 
-        for (int i = code.length - 1; i >= 0; i--) {
-            bit_buffer_add(&bit_buffer, (code.code >> i) & 1);
+    for (int c = 0; c < 256; c++) {
+        int len = lengths[c];
+        huff_table[c].code = len > 0 ? next_code[len]++ : 0;
+        huff_table[c].length = symbols > 1 ? len : 0;
+    }
+}
 
-            if (bit_buffer.bits_used == 8) { 
-                write_buffer(output_file, &bit_buffer);
+// Confere se os comprimentos formam um código de prefixo completo (igualdade de Kraft).
+static inline int valid_code_lengths(const uint8_t lengths[256]) {
+    uint64_t kraft = 0;
+    int symbols = 0;
+    for (int c = 0; c < 256; c++) {
+        if (lengths[c] > MAX_CODE_LENGTH) return 0;
+        if (lengths[c] > 0) {
+            kraft += (uint64_t)1 << (MAX_CODE_LENGTH - lengths[c]);
+            symbols++;
+        }
+    }
+    if (symbols <= 1) return 1;   // entrada vazia ou de um único símbolo
+    return kraft == ((uint64_t)1 << MAX_CODE_LENGTH);
+}
+
+// Reconstrói a árvore a partir dos códigos canônicos, para os decodificadores existentes.
+// A árvore é esvaziada antes; retorna a raiz (TREE_NIL se os códigos não couberem nela).
+static inline uint16_t build_tree_from_lengths(const uint8_t lengths[256], HUFF_TREE* tree) {
+    HuffmanCode huff_table[256];
+    assign_canonical_codes(lengths, huff_table);
+    tree_reset(tree);
+
+    for (int c = 0; c < 256; c++) {
+        if (lengths[c] > 0 && huff_table[c].length == 0) {
+            tree->root = create_node(tree, c, 0, TREE_NIL, TREE_NIL);   // único símbolo
+            return tree->root;
+        }
+    }
+
+    uint16_t root = create_node(tree, '\0', 0, TREE_NIL, TREE_NIL);
+    for (int c = 0; c < 256; c++) {
+        int len = huff_table[c].length;
+        if (len == 0) continue;
+
+        uint16_t current = root;
+        for (int i = len - 1; i >= 0 && current != TREE_NIL; i--) {
+            uint16_t* child = ((huff_table[c].code >> i) & 1) ? &tree->nodes[current].right : &tree->nodes[current].left;
+            if (*child == TREE_NIL) {
+                *child = i > 0 ? create_node(tree, '\0', 0, TREE_NIL, TREE_NIL)
+                               : create_node(tree, c, 0, TREE_NIL, TREE_NIL);
             }
+            current = *child;
         }
+        if (current == TREE_NIL) return TREE_NIL;   // mais nós que MAX_TREE_NODES
     }
 
-    write_buffer(output_file, &bit_buffer);
+    tree->root = root;
+    return root;
 }
 
-// Libera toda a memória alocada para a árvore de Huffman.
-void free_huffman_tree(NODE* root) {
-    if (root == NULL) return;
+// Gera a tabela de códigos a partir da árvore. Se alguma folha passa de MAX_CODE_LENGTH
+// bits, usa códigos canônicos limitados, reconstrói a árvore em "limited" e a retorna;
+// caso contrário retorna a própria "tree".
+static inline const HUFF_TREE* create_limited_huffman_table(const HUFF_TREE* tree, const uint64_t freq[256],
+                                                     HuffmanCode huff_table[256], HUFF_TREE* limited) {
+    if (tree_depth(tree, tree->root) <= MAX_CODE_LENGTH) {
+        create_huffman_table(tree, tree->root, 0, 0, huff_table);
+        return tree;
+    }
 
-    free_huffman_tree(root->left);
-    free_huffman_tree(root->right);
-    free(root);
+    uint8_t lengths[256];
+    compute_code_lengths(freq, MAX_CODE_LENGTH, lengths);
+    assign_canonical_codes(lengths, huff_table);
+    build_tree_from_lengths(lengths, limited);
+    return limited;
 }
 
-// Imprime a tabela de Huffman para depuração.
-void print_huff_table(HuffmanCode huff_table[256]) {
-    for (int i = 0; i < 256; i++) {
-        if (huff_table[i].length > 0) {
-            printf("'%c' (%d): Code: ", i, i);
-            for (int j = huff_table[i].length - 1; j >= 0; j--) {
-                printf("%d", (huff_table[i].code >> j) & 1);
-            }
-            printf(", Length: %d\n", huff_table[i].length);
-        }
+/*
+    CAMINHO RÁPIDO DE COMPACTAÇÃO (blocos + acumulador de 64 bits)
+*/
+
+// Acumula códigos inteiros em 64 bits e despeja a saída em blocos grandes.
+typedef struct {
+    uint64_t acc;
+    int bits;
+    size_t used;
+    FILE *file;
+    unsigned char out[IO_BLOCK_SIZE];
+} BitWriter;
+
+static inline void bit_writer_init(BitWriter *writer, FILE *file) {
+    writer->acc = 0;
+    writer->bits = 0;
+    writer->used = 0;
+    writer->file = file;
+}
+
+// Grava no arquivo os bytes completos acumulados no buffer de saída.
+static inline void bit_writer_drain(BitWriter *writer) {
+    if (writer->used > 0) {
+        fwrite(writer->out, 1, writer->used, writer->file);
+        writer->used = 0;
     }
 }
 
-// Imprime a árvore de Huffman para depuração.
-void print_huffman_tree(NODE* root, int level) {
-    if (!root) return;
+// Anexa um código inteiro (até 32 bits) com um único shift-or.
+static inline void bit_writer_put(BitWriter *writer, uint32_t code, int length) {
+    writer->acc = (writer->acc << length) | code;
+    writer->bits += length;
 
-    print_huffman_tree(root->right, level + 1);
+    if (writer->bits >= 32) {
+        if (writer->used + 4 > IO_BLOCK_SIZE) {
+            bit_writer_drain(writer);
+        }
+        unsigned char *out = writer->out + writer->used;
+        out[0] = (unsigned char)(writer->acc >> (writer->bits - 8));
+        out[1] = (unsigned char)(writer->acc >> (writer->bits - 16));
+        out[2] = (unsigned char)(writer->acc >> (writer->bits - 24));
+        out[3] = (unsigned char)(writer->acc >> (writer->bits - 32));
+        writer->used += 4;
+        writer->bits -= 32;
+    }
+}
 
-    for (int i = 0; i < level; i++) {
-        printf("    ");
+// Escreve os bits restantes, completando o último byte com zeros.
+static inline void bit_writer_flush(BitWriter *writer) {
+    while (writer->bits >= 8) {
+        if (writer->used == IO_BLOCK_SIZE) {
+            bit_writer_drain(writer);
+        }
+        writer->out[writer->used++] = (unsigned char)(writer->acc >> (writer->bits - 8));
+        writer->bits -= 8;
     }
 
-    if (is_leaf(root)) {
-        if (root->character >= 32 && root->character <= 126) {
-            printf("'%c' (%d)\n", root->character, root->frequency);
-        } else {
-            printf("0x%02X (%d)\n", root->character, root->frequency);
+    if (writer->bits > 0) {
+        if (writer->used == IO_BLOCK_SIZE) {
+            bit_writer_drain(writer);
         }
-    } else {
-        printf("* (%d)\n", root->frequency);
+        writer->out[writer->used++] = (unsigned char)(writer->acc << (8 - writer->bits));
+        writer->bits = 0;
     }
 
-    print_huffman_tree(root->left, level + 1);
+    bit_writer_drain(writer);
+}
+
+// Codifica um bloco de bytes em memória no escritor de bits.
+static inline void bit_writer_encode(BitWriter *writer, const unsigned char *data, size_t size, HuffmanCode huff_table[256]) {
+    for (size_t i = 0; i < size; i++) {
+        HuffmanCode code = huff_table[data[i]];
+        bit_writer_put(writer, code.code, code.length);
+    }
+}
+
+// Mesma saída de compactor(), mas lendo a entrada em blocos e escrevendo códigos inteiros.
+static inline void compactor_fast(FILE *input_file, FILE *output_file, HuffmanCode huff_table[256]) {
+    unsigned char *in = malloc(IO_BLOCK_SIZE);
+    BitWriter *writer = malloc(sizeof(BitWriter));
+    bit_writer_init(writer, output_file);
+
+    size_t n;
+    while ((n = fread(in, 1, IO_BLOCK_SIZE, input_file)) > 0) {
+        bit_writer_encode(writer, in, n, huff_table);
+    }
+
+    bit_writer_flush(writer);
+    free(writer);
+    free(in);
+}
+
+// Compacta uma entrada que já está inteira em memória.
+static inline void compactor_buffer(const unsigned char *data, size_t size, FILE *output_file, HuffmanCode huff_table[256]) {
+    BitWriter *writer = malloc(sizeof(BitWriter));
+    bit_writer_init(writer, output_file);
+    bit_writer_encode(writer, data, size, huff_table);
+    bit_writer_flush(writer);
+    free(writer);
+}
+
+// Entradas até este tamanho são lidas do disco uma única vez e mantidas em memória.
+#define MAX_BUFFERED_INPUT ((long)256 << 20)
+
+// Carrega o arquivo inteiro em memória. Retorna NULL se ele não couber no limite.
+static inline unsigned char* load_input(FILE *input_file, size_t *size) {
+    if (fseek(input_file, 0, SEEK_END) != 0) return NULL;
+    long file_size = ftell(input_file);
+    rewind(input_file);
+    if (file_size < 0 || file_size > MAX_BUFFERED_INPUT) return NULL;
+
+    unsigned char *data = malloc(file_size > 0 ? file_size : 1);
+    size_t total = 0, n;
+    while (total < (size_t)file_size &&
+           (n = fread(data + total, 1, file_size - total, input_file)) > 0) {
+        total += n;
+    }
+
+    *size = total;
+    return data;
 }
 
 /*
@@ -213,19 +560,21 @@ void print_huffman_tree(NODE* root, int level) {
 */
 
 // Lê os dois bytes de cabeçalho e extrai o lixo e o tamanho da árvore.
-void read_header(FILE *file, int *trash, int *tree_size) {
+// Retorna -1 se o arquivo tiver menos de dois bytes.
+static inline int read_header(FILE *file, int *trash, int *tree_size) {
     unsigned char byte1, byte2;
-    fread(&byte1, 1, 1, file);
-    fread(&byte2, 1, 1, file);
+    if (fread(&byte1, 1, 1, file) != 1 || fread(&byte2, 1, 1, file) != 1) return -1;
 
     unsigned short header = (byte1 << 8) | byte2;
 
     *trash = header >> 13;
     *tree_size = header & 0x1FFF;
+    return 0;
 }
 
-// Lê a representação da árvore do arquivo e a reconstrói.
-NODE* read_tree(FILE *file, int *bytes_read) { 
+// Lê a representação da árvore do arquivo e a reconstrói dentro de "tree".
+// Retorna TREE_NIL se a árvore estiver truncada, malformada ou tiver nós demais.
+static inline uint16_t read_tree(HUFF_TREE* tree, FILE *file, int *bytes_read) { 
     int c = fgetc(file);
     (*bytes_read)++;
 
@@ -238,83 +587,281 @@ NODE* read_tree(FILE *file, int *bytes_read) {
             (*bytes_read)++;
         }
 
-        return create_node((unsigned char)next, 0, NULL, NULL);
+        if (next == EOF) return TREE_NIL;
+        return create_node(tree, (unsigned char)next, 0, TREE_NIL, TREE_NIL);
 
     } else if (c == '0') {
-        NODE *left = read_tree(file, bytes_read);
-        NODE *right = read_tree(file, bytes_read);
-        return create_node('\0', 0, left, right);
+        uint16_t left = read_tree(tree, file, bytes_read);
+        if (left == TREE_NIL) return TREE_NIL;
+        uint16_t right = read_tree(tree, file, bytes_read);
+        if (right == TREE_NIL) return TREE_NIL;
+        return create_node(tree, '\0', 0, left, right);
+    }
+
+    return TREE_NIL;
+}
+
+/*
+    DECODIFICAÇÃO POR TABELA (vários símbolos por consulta)
+*/
+
+#define DECODE_TABLE_BITS 11
+#define DECODE_MAX_SYMBOLS 4
+
+// Resultado de decodificar os próximos DECODE_TABLE_BITS bits a partir da raiz.
+typedef struct {
+    unsigned char symbols[DECODE_MAX_SYMBOLS];
+    uint8_t count;  // símbolos completos encontrados (0 = código longo)
+    uint8_t bits;   // bits consumidos pelos símbolos encontrados
+    uint16_t node;  // código longo: nó alcançado após DECODE_TABLE_BITS bits
+} DecodeEntry;
+
+typedef struct {
+    DecodeEntry entries[1 << DECODE_TABLE_BITS];
+} DecodeTable;
+
+// Preenche cada entrada simulando a descida na árvore com os bits do índice.
+// Com next_table (modelo de contexto), a entrada para depois do primeiro símbolo
+// que troca a tabela do próximo: next_table[símbolo] != self.
+static inline void build_decode_table_for(const HUFF_TREE* tree, DecodeTable *table, const uint8_t *next_table, int self) {
+    for (int idx = 0; idx < (1 << DECODE_TABLE_BITS); idx++) {
+        DecodeEntry *entry = &table->entries[idx];
+        uint16_t current = tree->root;
+        entry->count = 0;
+        entry->bits = 0;
+        entry->node = TREE_NIL;
+
+        for (int b = 0; b < DECODE_TABLE_BITS; b++) {
+            int bit = (idx >> (DECODE_TABLE_BITS - 1 - b)) & 1;
+            current = bit ? tree->nodes[current].right : tree->nodes[current].left;
+
+            if (is_leaf(tree, current)) {
+                unsigned char symbol = tree->nodes[current].character;
+                entry->symbols[entry->count++] = symbol;
+                entry->bits = b + 1;
+                current = tree->root;
+                if (entry->count == DECODE_MAX_SYMBOLS) break;
+                if (next_table && next_table[symbol] != self) break;
+            }
+        }
+
+        if (entry->count == 0) {
+            entry->bits = DECODE_TABLE_BITS;
+            entry->node = current;
+        }
+    }
+}
+
+static inline void build_decode_table(const HUFF_TREE* tree, DecodeTable *table) {
+    build_decode_table_for(tree, table, NULL, 0);
+}
+
+// Lê o fluxo de bits em blocos, mantendo os próximos bits alinhados à esquerda em 64 bits.
+typedef struct {
+    uint64_t acc;
+    int bits;
+    size_t pos, len;
+    FILE *file;
+    unsigned char in[IO_BLOCK_SIZE];
+} BitReader;
+
+static inline void bit_reader_init(BitReader *reader, FILE *file) {
+    reader->acc = 0;
+    reader->bits = 0;
+    reader->pos = 0;
+    reader->len = 0;
+    reader->file = file;
+}
+
+static inline void bit_reader_refill(BitReader *reader) {
+    while (reader->bits <= 56) {
+        if (reader->pos == reader->len) {
+            reader->len = fread(reader->in, 1, IO_BLOCK_SIZE, reader->file);
+            reader->pos = 0;
+            if (reader->len == 0) return;
+        }
+        reader->acc |= (uint64_t)reader->in[reader->pos++] << (56 - reader->bits);
+        reader->bits += 8;
     }
+}
 
-    return NULL;
+static inline void bit_reader_consume(BitReader *reader, int n) {
+    reader->acc <<= n;
+    reader->bits -= n;
 }
 
-// Decodifica os bits do arquivo compactado usando a árvore e escreve o resultado.
-void decompress(FILE *input, FILE *output, NODE* root, int trash_size, int header_bytes) {
+// Consome um bit, reabastecendo o acumulador quando necessário.
+static inline int bit_reader_bit(BitReader *reader) {
+    if (reader->bits == 0) bit_reader_refill(reader);
+    int bit = (int)(reader->acc >> 63);
+    bit_reader_consume(reader, 1);
+    return bit;
+}
+
+// Decodifica os bits do formato original consultando a tabela e escrevendo em blocos.
+// Retorna -1 se os bits declarados pelo cabeçalho terminam no meio de um código.
+static inline int decompress_fast(FILE *input, FILE *output, const HUFF_TREE* tree, int trash_size, int header_bytes) {
     fseek(input, 0, SEEK_END);
     long file_size = ftell(input);
     long data_size = file_size - header_bytes;
     fseek(input, header_bytes, SEEK_SET);
 
-    NODE* current = root;
-    unsigned char byte;
-    for (long i = 0; i < data_size; i++) {
-        fread(&byte, 1, 1, input);
-
-        for (int bit = 7; bit >= 0; bit--) {
-            int current_bit = (byte >> bit) & 1;
-            if (current_bit == 0)
-                current = current->left;
-            else
-                current = current->right;
-
-            if (is_leaf(current)) {
-                fputc(current->character, output);
-                current = root;
+    if (data_size <= 0) return -1;     // o codificador recusa entradas vazias
+
+    DecodeTable *table = malloc(sizeof(DecodeTable));
+    BitReader *reader = malloc(sizeof(BitReader));
+    unsigned char *out = malloc(IO_BLOCK_SIZE);
+    size_t used = 0;
+
+    build_decode_table(tree, table);
+    bit_reader_init(reader, input);
+
+    int status = 0;
+    uint64_t remaining = (uint64_t)data_size * 8 - trash_size;
+    while (remaining > 0) {
+        if (used + DECODE_MAX_SYMBOLS > IO_BLOCK_SIZE) {
+            fwrite(out, 1, used, output);
+            used = 0;
+        }
+        if (reader->bits < DECODE_TABLE_BITS) bit_reader_refill(reader);
+
+        uint16_t current = tree->root;
+        if (remaining >= DECODE_TABLE_BITS) {
+            DecodeEntry *entry = &table->entries[reader->acc >> (64 - DECODE_TABLE_BITS)];
+            bit_reader_consume(reader, entry->bits);
+            remaining -= entry->bits;
+
+            if (entry->count > 0) {
+                memcpy(out + used, entry->symbols, DECODE_MAX_SYMBOLS);
+                used += entry->count;
+                continue;
             }
+            current = entry->node;
+        }
 
-            if (i == data_size - 1 && bit == trash_size - 1) {
-                return;
+        // Códigos longos e o final do fluxo seguem a árvore bit a bit.
+        while (remaining > 0) {
+            current = bit_reader_bit(reader) ? tree->nodes[current].right : tree->nodes[current].left;
+            remaining--;
+            if (is_leaf(tree, current)) {
+                out[used++] = tree->nodes[current].character;
+                break;
             }
         }
+        if (!is_leaf(tree, current)) {
+            status = -1;
+            break;
+        }
     }
+
+    fwrite(out, 1, used, output);
+    free(out);
+    free(reader);
+    free(table);
+    return status;
 }
 
-// Função principal de descompactação.
-void decompact(const char* compressed_filename, char final_format[]) {
-    FILE *input_file = fopen(compressed_filename, "rb"); 
-    if (!input_file) {
-        perror("Erro ao abrir o arquivo compactado");
-        return;
+// Árvores do formato original, reaproveitadas entre arquivos pela mesma thread:
+// processar muitos arquivos pequenos não aloca nem libera nós. A segunda só é usada
+// quando a árvore precisa ser refeita com códigos limitados.
+static _Thread_local HUFF_TREE legacy_trees[2];
+
+// Descompacta um arquivo no formato original (cabeçalho de 2 bytes + árvore + bits).
+static inline int legacy_decompress(FILE *input_file, FILE *output_file) {
+    if (fseek(input_file, 0, SEEK_CUR) != 0) {
+        fprintf(stderr, "Erro: o formato original exige uma entrada com seek\n");
+        return -1;
     }
 
-    char output_filename[BUFFER_SIZE]; 
-    strcpy(output_filename, compressed_filename); 
-    char* dot = strrchr(output_filename, '.');  
-    if (dot) *dot = '\0';  
+    int trash_size = 0, tree_size = 0, bytes_read = 0;
+    if (read_header(input_file, &trash_size, &tree_size) != 0) {
+        fprintf(stderr, "Erro: cabeçalho truncado\n");
+        return -1;
+    }
 
-   snprintf(output_filename, sizeof(output_filename), "%.*s_descompactado.%s", 
-        (int)(sizeof(output_filename) - strlen("_descompactado.") - strlen(final_format) - 1), 
-        output_filename, 
-        final_format);
+    // O formato original não tem checksum: o tamanho da árvore gravado no cabeçalho
+    // é a única conferência possível da árvore lida.
+    HUFF_TREE* tree = &legacy_trees[0];
+    tree_reset(tree);
+    tree->root = read_tree(tree, input_file, &bytes_read);
+    // Uma árvore de uma só folha não codifica nada: vem de um arquivo que perdeu os dados.
+    if (tree->root == TREE_NIL || is_leaf(tree, tree->root) || count_tree_size(tree, tree->root) != tree_size) {
+        fprintf(stderr, "Erro: árvore inválida no cabeçalho\n");
+        return -1;
+    }
 
-    FILE *output_file = fopen(output_filename, "wb");
-    if (!output_file) {
-        perror("Erro ao criar arquivo de saída");
-        fclose(input_file);
-        return;
+    if (decompress_fast(input_file, output_file, tree, trash_size, 2 + bytes_read) != 0) {
+        fprintf(stderr, "Erro: dados compactados truncados ou corrompidos\n");
+        return -1;
     }
+    return ferror(output_file) ? -1 : 0;
+}
 
-    int trash_size = 0, tree_size = 0, bytes_read = 0;
-    read_header(input_file, &trash_size, &tree_size);
-    NODE* root = read_tree(input_file, &bytes_read);
-    decompress(input_file, output_file, root, trash_size, 2 + bytes_read);
+// Monta a árvore a partir do histograma e escreve cabeçalho e árvore do formato original.
+// Preenche huff_table com os códigos. Retorna -1 se não houver nenhum símbolo.
+static inline int legacy_write_header(const uint64_t freq[256], FILE *new_file, HuffmanCode huff_table[256]) {
+    HUFF_TREE* tree = &legacy_trees[0];
+
+    // Constrói a árvore de Huffman
+    if (build_huffman_tree_sorted(tree, freq) == TREE_NIL) {
+        fprintf(stderr, "Erro: o formato original não suporta arquivos vazios\n");
+        return -1;
+    }
+
+    // Um único símbolo ganha uma folha irmã que nunca aparece: assim ele tem um código
+    // de 1 bit e o número de repetições fica nos bits (o formato não guarda o tamanho).
+    if (is_leaf(tree, tree->root)) {
+        uint16_t only = tree->root;
+        uint16_t unused = create_node(tree, tree->nodes[only].character ^ 1, 0, TREE_NIL, TREE_NIL);
+        tree->root = create_node(tree, '\0', tree->nodes[only].frequency, only, unused);
+    }
+
+    // Cria a tabela de códigos de Huffman (limitada a MAX_CODE_LENGTH bits)
+    const HUFF_TREE* code_tree = create_limited_huffman_table(tree, freq, huff_table, &legacy_trees[1]);
+
+    // Escreve o cabeçalho e a árvore no novo arquivo
+    write_header(freq, huff_table, new_file, code_tree);
+    return 0;
+}
+
+// Compacta no formato original uma entrada que já está em memória.
+static inline int legacy_compress_buffer(const unsigned char *data, size_t data_size, FILE *new_file) {
+    uint64_t freq[256] = {0};
+    HuffmanCode huff_table[256] = {0};
+
+    count_frequencies(data, data_size, freq);
+    if (legacy_write_header(freq, new_file, huff_table) != 0) return -1;
+
+    compactor_buffer(data, data_size, new_file, huff_table);
+    return ferror(new_file) ? -1 : 0;
+}
+
+// Compacta no formato original: uma única árvore para o arquivo inteiro.
+static inline int legacy_compress(FILE *original_file, FILE *new_file) {
+    // O formato original precisa conhecer a árvore antes dos bits: são duas leituras.
+    if (fseek(original_file, 0, SEEK_CUR) != 0) {
+        fprintf(stderr, "Erro: o formato original exige uma entrada com seek (use o formato em blocos)\n");
+        return -1;
+    }
+
+    // Lê o arquivo uma única vez quando ele cabe em memória
+    size_t data_size = 0;
+    unsigned char* data = load_input(original_file, &data_size);
+    if (data) {
+        int status = legacy_compress_buffer(data, data_size, new_file);
+        free(data);
+        return status;
+    }
 
-    printf("Arquivo descompactado com sucesso: %s\n", output_filename);
+    // Arquivo grande demais para a memória: uma leitura para as frequências e outra para os bits
+    uint64_t freq[256] = {0};
+    HuffmanCode huff_table[256] = {0};
+    count_file_frequencies(original_file, freq);
+    if (legacy_write_header(freq, new_file, huff_table) != 0) return -1;
 
-    free_huffman_tree(root);
-    fclose(input_file);
-    fclose(output_file);
+    rewind(original_file);
+    compactor_fast(original_file, new_file, huff_table);
+    return ferror(new_file) ? -1 : 0;
 }
 
 #endif // HUFFMAN_H
\ No newline at end of file
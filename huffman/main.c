@@ -1,108 +1,353 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdint.h>  // Para uint32_t
-#include <ctype.h>   // Para validações de entrada, se desejar
-#include "huffman.h"
-#include "pqueue_heap.h"
+#include <stdint.h>
+#include <unistd.h>  // Para getopt
+#include "huff.h"
 
 #define BUFFER_SIZE 1024
+#define COPY_BUFFER_SIZE (1 << 16)
+#define MAX_THREADS 1024
 
-int main() {
+// Monta o nome de saída "<nome sem extensão>_descompactado.<formato>".
+void make_output_filename(const char* compressed_filename, const char* final_format, char output_filename[BUFFER_SIZE]) {
+    char base_name[BUFFER_SIZE];
+    snprintf(base_name, sizeof(base_name), "%s", compressed_filename);
+    char* dot = strrchr(base_name, '.');
+    if (dot) *dot = '\0';
+
+    snprintf(output_filename, BUFFER_SIZE, "%.*s_descompactado.%s",
+        (int)(BUFFER_SIZE - strlen("_descompactado.") - strlen(final_format) - 1),
+        base_name,
+        final_format);
+}
+
+// Troca a extensão do arquivo por ".huff".
+void make_huff_filename(const char* filename, char new_file_name[BUFFER_SIZE]) {
+    char base_name[BUFFER_SIZE];
+    snprintf(base_name, sizeof(base_name), "%s", filename);
+    char* dot = strrchr(base_name, '.');
+    if (dot != NULL) {
+        *dot = '\0'; // termina a string antes do ponto
+    }
+
+    snprintf(new_file_name, BUFFER_SIZE, "%.*s.huff",
+        (int)(BUFFER_SIZE - strlen(".huff") - 1),
+        base_name);
+}
+
+// Copia "length" bytes a partir de "offset" de um arquivo em blocos para output.
+unsigned long long extract_range(HuffArchiveHandle* archive, unsigned long long offset,
+                                 unsigned long long length, FILE* output) {
+    unsigned char* buffer = malloc(COPY_BUFFER_SIZE);
+    unsigned long long extracted = 0;
+
+    // Copia o intervalo em pedaços, decodificando apenas os blocos envolvidos
+    while (extracted < length) {
+        size_t want = length - extracted < COPY_BUFFER_SIZE ? length - extracted : COPY_BUFFER_SIZE;
+        size_t got = huff_archive_read(archive, offset + extracted, buffer, want);
+        fwrite(buffer, 1, got, output);
+        extracted += got;
+        if (got < want) break;
+    }
+
+    free(buffer);
+    return extracted;
+}
+
+/*
+    MENU INTERATIVO (executado quando o programa é chamado sem argumentos, no terminal)
+*/
+
+int run_menu() {
     int option;
-    
+
     printf("====== Compactador Huffman ======\n");
     printf("Escolha uma opção:\n");
     printf("1 - Compactar arquivo\n");
     printf("2 - Descompactar arquivo\n");
+    printf("3 - Compactar arquivo em blocos (multi-thread)\n");
+    printf("4 - Extrair intervalo de um arquivo em blocos\n");
     printf("Opção: ");
     scanf("%d", &option);
     getchar(); // Limpa o buffer do ENTER
 
-    if (option == 1) {
-        printf("\nInsira o nome do arquivo a ser compactado, com a extensao:\n");
+    HuffOptions options;
+    huff_default_options(&options);
 
+    if (option == 1 || option == 3) {
         char filename[BUFFER_SIZE];
-        scanf("%s", filename);
+        printf("\nInsira o nome do arquivo a ser compactado, com a extensao:\n");
+        scanf("%1023s", filename);
 
-        FILE* original_file = fopen(filename, "rb");
-        if (original_file == NULL) {
-            perror("Erro ao abrir o arquivo");
+        if (option == 1) {
+            options.format = HUFF_FORMAT_LEGACY;
+        } else {
+            printf("\nInsira o numero de threads (0 = todos os nucleos):\n");
+            if (scanf("%d", &options.threads) != 1 || options.threads < 0 || options.threads > MAX_THREADS) {
+                fprintf(stderr, "Número de threads inválido (use 0 a %d)\n", MAX_THREADS);
+                return 1;
+            }
+        }
+
+        // Cria um novo nome com extensão .huff
+        char new_file_name[BUFFER_SIZE];
+        make_huff_filename(filename, new_file_name);
+
+        if (huff_compress_file(filename, new_file_name, &options) != 0) {
+            fprintf(stderr, "Erro ao compactar o arquivo\n");
             return 1;
         }
+        printf("Arquivo compactado com sucesso: %s\n", new_file_name);
 
-        // Remove a extensão do nome do arquivo
-        char base_name[BUFFER_SIZE];
-        strcpy(base_name, filename);
+    } else if (option == 2) {
+        char compressed_filename[BUFFER_SIZE];
+        char final_format[10];
+        printf("\nInsira o nome do arquivo compactado (.huff):\n");
+        scanf("%1023s", compressed_filename);
+
+        printf("\nInsira o formato da extensao final (ex: jpg, txt, etc):\n");
+        scanf("%9s", final_format);
+
+        char output_filename[BUFFER_SIZE];
+        make_output_filename(compressed_filename, final_format, output_filename);
 
-        char* dot = strrchr(base_name, '.');
-        if (dot != NULL) {
-            *dot = '\0'; // termina a string antes do ponto
+        if (huff_decompress_file(compressed_filename, output_filename, &options) != 0) {
+            fprintf(stderr, "Erro ao descompactar o arquivo\n");
+            return 1;
         }
+        printf("Arquivo descompactado com sucesso: %s\n", output_filename);
 
-        // Cria um novo nome com extensão .huff
-        char new_file_name[1024];
-        snprintf(new_file_name, sizeof(new_file_name), "%.*s.huff", 
-        (int)(sizeof(new_file_name) - strlen(".huff") - 1), 
-        base_name); //mudanca
+    } else if (option == 4) {
+        char compressed_filename[BUFFER_SIZE];
+        char output_filename[BUFFER_SIZE];
+        unsigned long long offset, length;
+        printf("\nInsira o nome do arquivo compactado em blocos (.huff):\n");
+        scanf("%1023s", compressed_filename);
 
-        FILE *new_file = fopen(new_file_name, "wb");
-        if (new_file == NULL) {
+        printf("\nInsira o offset inicial e a quantidade de bytes:\n");
+        scanf("%llu %llu", &offset, &length);
+
+        printf("\nInsira o nome do arquivo de saida:\n");
+        scanf("%1023s", output_filename);
+
+        HuffArchiveHandle* archive = huff_archive_open(compressed_filename);
+        if (archive == NULL) {
+            return 1;
+        }
+
+        FILE *output_file = fopen(output_filename, "wb");
+        if (output_file == NULL) {
             perror("Erro ao criar o arquivo de saída");
-            fclose(original_file);
+            huff_archive_close(archive);
             return 1;
         }
 
-        // Cria as duas filas de prioridade
-        PRIORITY_QUEUE* huff_queue1 = create_queue();
-        PRIORITY_QUEUE* huff_queue2 = create_queue();
+        unsigned long long extracted = extract_range(archive, offset, length, output_file);
+        fclose(output_file);
+        huff_archive_close(archive);
 
-        // Preenche as filas com as frequências dos caracteres do arquivo
-        create_huff_queue(original_file, &huff_queue1, &huff_queue2);
+        printf("%llu bytes extraidos para %s\n", extracted, output_filename);
 
-        // Constrói a árvore de Huffman
-        NODE* root = build_huffman_tree(huff_queue1);
+    } else {
+        printf("Opção inválida.\n");
+    }
 
-        // Cria a tabela de códigos de Huffman
-        HuffmanCode huff_table[256] = {0}; // Inicializa a tabela de Huffman
-        uint32_t code = 0; // Inicializa o código como um inteiro
-        create_huffman_table(root, code, 0, huff_table); // Passa o código como ponteiro
+    return 0;
+}
 
-        // Escreve o cabeçalho e a árvore no novo arquivo
-        write_header(huff_queue2, huff_table, new_file, root);
+/*
+    LINHA DE COMANDO
+*/
 
-        // Libera memória usada
-        free_huffman_tree(root);
-        free_priority_queue(huff_queue1);
-        free_priority_queue(huff_queue2);
+void print_usage(const char* program) {
+    fprintf(stderr,
+        "Uso: %s [-c | -d | -v | -r OFFSET:BYTES] [opções] [ARQUIVO...]\n"
+        "  -c              compacta (padrão); ARQUIVO vira ARQUIVO.huff\n"
+        "  -d              descompacta; ARQUIVO.huff vira ARQUIVO\n"
+        "  -v              confere os checksums de ARQUIVO.huff sem gravar a saída\n"
+        "  -r OFFSET:BYTES extrai um intervalo do original de um arquivo em blocos\n"
+        "  -o SAIDA        caminho de saída (apenas com um arquivo de entrada)\n"
+        "  -t N            número de threads (0 = todos os núcleos; até 1024)\n"
+        "  -b TAMANHO      tamanho do bloco em bytes (aceita sufixos K e M)\n"
+        "  -l BITS         comprimento máximo dos códigos (8 a 32)\n"
+        "  -s              tabela própria em cada bloco (modo fluxo)\n"
+        "  -C              tabelas por contexto (classe do byte anterior) em cada bloco\n"
+        "  -L              formato original de um único bloco\n"
+        "  -M              não usa mmap; lê e escreve os arquivos com stdio\n"
+        "Sem ARQUIVO (ou com \"-\"), lê da entrada padrão e escreve em SAIDA (-o) ou na saída padrão.\n"
+        "Sem nenhum argumento e com a entrada padrão no terminal, abre o menu interativo.\n",
+        program);
+}
 
-        // Reposiciona o ponteiro do arquivo original para o início
-        rewind(original_file);
+// Lê um tamanho como "512K" ou "4M". Retorna 0 se o valor for inválido.
+uint32_t parse_size(const char* text) {
+    char* end;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (*end == 'K' || *end == 'k') { value <<= 10; end++; }
+    else if (*end == 'M' || *end == 'm') { value <<= 20; end++; }
+    if (*end != '\0' || value > UINT32_MAX) return 0;
+    return (uint32_t)value;
+}
 
-        // Compacta os dados do arquivo original usando a tabela de Huffman
-        compactor(original_file, new_file, huff_table);
+// Converte um inteiro decimal entre min e max. Retorna -1 se o texto não for só isso.
+int parse_int(const char* text, int min, int max) {
+    char* end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < min || value > max) return -1;
+    return (int)value;
+}
 
-        // Fecha os arquivos
-        fclose(original_file);
-        fclose(new_file);
+// Nome de saída padrão: acrescenta ".huff" ao compactar e o remove ao descompactar.
+int default_output_path(const char* input, int decompress, char output[BUFFER_SIZE]) {
+    size_t len = strlen(input);
+    if (!decompress) {
+        return snprintf(output, BUFFER_SIZE, "%s.huff", input) < BUFFER_SIZE ? 0 : -1;
+    }
+    if (len <= 5 || strcmp(input + len - 5, ".huff") != 0) {
+        fprintf(stderr, "%s: extensão .huff ausente; use -o para escolher a saída\n", input);
+        return -1;
+    }
+    snprintf(output, BUFFER_SIZE, "%.*s", (int)(len - 5), input);
+    return 0;
+}
 
-        printf("Arquivo compactado com sucesso: %s\n", new_file_name);
+int main(int argc, char *argv[]) {
+    if (argc == 1 && isatty(STDIN_FILENO)) {
+        return run_menu();
+    }
 
-    } else if (option == 2) {
-        char compressed_filename[BUFFER_SIZE];
-        char final_format[10];
-        printf("\nInsira o nome do arquivo compactado (.huff):\n");
-        scanf("%s", compressed_filename);
+    HuffOptions options;
+    huff_default_options(&options);
+    int decompress = 0, extract = 0, verify = 0;
+    unsigned long long offset = 0, length = 0;
+    const char* output_path = NULL;
+    int opt;
 
-        printf("\nInsira o formato da extensao final (ex: jpg, txt, etc):\n");
-        scanf("%s", final_format);
+    while ((opt = getopt(argc, argv, "cdvr:o:t:b:l:sCLMh")) != -1) {
+        switch (opt) {
+            case 'c': decompress = 0; break;
+            case 'd': decompress = 1; break;
+            case 'v': verify = 1; break;
+            case 'r':
+                if (sscanf(optarg, "%llu:%llu", &offset, &length) != 2) {
+                    fprintf(stderr, "Intervalo inválido: %s\n", optarg);
+                    return 2;
+                }
+                extract = 1;
+                break;
+            case 'o': output_path = optarg; break;
+            case 't':
+                options.threads = parse_int(optarg, 0, MAX_THREADS);
+                if (options.threads < 0) {
+                    fprintf(stderr, "Número de threads inválido: %s (use 0 a %d)\n", optarg, MAX_THREADS);
+                    return 2;
+                }
+                break;
+            case 'b':
+                options.block_size = parse_size(optarg);
+                if (options.block_size == 0) {
+                    fprintf(stderr, "Tamanho de bloco inválido: %s\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'l':
+                options.max_code_length = parse_int(optarg, 8, 32);
+                if (options.max_code_length < 0) {
+                    fprintf(stderr, "Comprimento máximo de código inválido: %s (use 8 a 32)\n", optarg);
+                    return 2;
+                }
+                break;
+            case 's': options.block_tables = 1; break;
+            case 'C': options.context = 1; break;
+            case 'L': options.format = HUFF_FORMAT_LEGACY; break;
+            case 'M': options.no_mmap = 1; break;
+            default:
+                print_usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
 
-        decompact(compressed_filename, final_format);
+    int files = argc - optind;
+    if (files > 1 && output_path) {
+        fprintf(stderr, "-o só pode ser usado com um arquivo de entrada\n");
+        return 2;
+    }
 
-    } else {
-        printf("Opção inválida.\n");
+    if (extract) {
+        if (files != 1) {
+            fprintf(stderr, "-r precisa de exatamente um arquivo em blocos\n");
+            return 2;
+        }
+        HuffArchiveHandle* archive = huff_archive_open(argv[optind]);
+        if (!archive) return 1;
+
+        FILE* output = output_path ? fopen(output_path, "wb") : stdout;
+        if (!output) {
+            perror(output_path);
+            huff_archive_close(archive);
+            return 1;
+        }
+        unsigned long long extracted = extract_range(archive, offset, length, output);
+        if (output != stdout) fclose(output);
+        huff_archive_close(archive);
+        return extracted == length ? 0 : 1;
     }
 
-    return 0;
-}
+    // Verificação: nada é gravado; o resultado de cada arquivo vai para a saída padrão.
+    if (verify) {
+        if (files == 0 || (files == 1 && strcmp(argv[optind], "-") == 0)) {
+            return huff_verify_fd(STDIN_FILENO, &options) == 0 ? 0 : 1;
+        }
+        int failures = 0;
+        for (int i = optind; i < argc; i++) {
+            int ok = (strcmp(argv[i], "-") == 0 ? huff_verify_fd(STDIN_FILENO, &options)
+                                                : huff_verify_file(argv[i], &options)) == 0;
+            printf("%s: %s\n", argv[i], ok ? "OK" : "CORROMPIDO");
+            if (!ok) failures++;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+    // Entrada padrão (nenhum arquivo ou "-") -> arquivo de -o ou saída padrão (pipes)
+    if (files == 0 || (files == 1 && strcmp(argv[optind], "-") == 0)) {
+        FILE* output = output_path ? fopen(output_path, "wb") : stdout;
+        if (!output) {
+            perror(output_path);
+            return 1;
+        }
+        int status = decompress ? huff_decompress_fd(STDIN_FILENO, fileno(output), &options)
+                                : huff_compress_fd(STDIN_FILENO, fileno(output), &options);
+        if (output != stdout && fclose(output) != 0) status = -1;
+        return status == 0 ? 0 : 1;
+    }
+
+    // Vários arquivos são processados no mesmo processo, sem custo de inicialização por arquivo.
+    int failures = 0;
+    for (int i = optind; i < argc; i++) {
+        if (strcmp(argv[i], "-") == 0) {
+            fprintf(stderr, "-: a entrada padrão só pode ser usada como único arquivo\n");
+            failures++;
+            continue;
+        }
+
+        char default_path[BUFFER_SIZE];
+        const char* target = output_path;
+        if (!target) {
+            if (default_output_path(argv[i], decompress, default_path) != 0) {
+                failures++;
+                continue;
+            }
+            target = default_path;
+        }
 
+        int status = decompress ? huff_decompress_file(argv[i], target, &options)
+                                : huff_compress_file(argv[i], target, &options);
+        if (status != 0) {
+            fprintf(stderr, "%s: falha\n", argv[i]);
+            failures++;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -4,47 +4,69 @@
 #include "huffman.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 
 #define MAX_HEAP 256
+#define MAX_TREE_NODES 511      // 256 folhas + 255 nós internos
+#define TREE_NIL 0xFFFF         // índice de "sem filho"
 
-typedef struct NODE {
+typedef struct {
+    uint64_t frequency;
+    uint16_t left, right;       // índices em HUFF_TREE.nodes
     unsigned char character;
-    int frequency;
-    struct NODE *left, *right;
 } NODE;
 
+/*
+    Árvore de Huffman em um único vetor: os filhos são índices de 16 bits,
+    não ponteiros. A árvore é alocada de uma vez e reaproveitada (tree_reset)
+    entre arquivos e blocos, sem um malloc/free por nó.
+*/
+typedef struct {
+    NODE nodes[MAX_TREE_NODES];
+    int count;
+    uint16_t root;
+} HUFF_TREE;
+
 typedef struct {
-    NODE* data[MAX_HEAP];
+    uint16_t data[MAX_HEAP];
     int size;
+    const HUFF_TREE* tree;      // onde estão as frequências dos nós da fila
 } PRIORITY_QUEUE;
 
+static inline void tree_reset(HUFF_TREE* tree) {
+    tree->count = 0;
+    tree->root = TREE_NIL;
+}
+
 /*
-    Create a new node assining the given parameters
+    Create a new node assining the given parameters.
+    Returns TREE_NIL if the tree is already full.
 */
-NODE* create_node(unsigned char c, int freq, NODE* left, NODE* right) {
-    NODE* NODE = malloc(sizeof(*NODE));
-    NODE->character = c;
-    NODE->frequency = freq;
-    NODE->left = left;
-    NODE->right = right;
-    return NODE;
+static inline uint16_t create_node(HUFF_TREE* tree, unsigned char c, uint64_t freq, uint16_t left, uint16_t right) {
+    if (tree->count >= MAX_TREE_NODES) return TREE_NIL;
+
+    NODE* node = &tree->nodes[tree->count];
+    node->character = c;
+    node->frequency = freq;
+    node->left = left;
+    node->right = right;
+    return (uint16_t)tree->count++;
 }
 
 
 /*
-    Create a new priority queue
+    Create a new priority queue over the nodes of a tree
 */
-PRIORITY_QUEUE* create_queue() {
+static inline PRIORITY_QUEUE* create_queue(const HUFF_TREE* tree) {
     PRIORITY_QUEUE* pq = malloc(sizeof(PRIORITY_QUEUE));
     pq->size = 0;
+    pq->tree = tree;
     return pq;
 }
 
-// Adicione isso antes de qualquer uso da função
-void free_huffman_tree(NODE* root);
-
-int is_empty(PRIORITY_QUEUE* pq) {
-    return pq->size == 0;
+static inline uint64_t queue_frequency(PRIORITY_QUEUE* pq, int idx) {
+    return pq->tree->nodes[pq->data[idx]].frequency;
 }
 
 
@@ -52,8 +74,8 @@ int is_empty(PRIORITY_QUEUE* pq) {
 /*
     Troca dois nós
 */
-void swap(NODE** a, NODE** b) {
-    NODE* temp = *a;
+static inline void swap(uint16_t* a, uint16_t* b) {
+    uint16_t temp = *a;
     *a = *b;
     *b = temp;
 }
@@ -62,9 +84,9 @@ void swap(NODE** a, NODE** b) {
 /*
     Reorganiza a heap quando um novo no é adicionado 
 */
-void heapify_up(PRIORITY_QUEUE* pq, int idx) {
+static inline void heapify_up(PRIORITY_QUEUE* pq, int idx) {
     int dad = (idx - 1) / 2;
-    if (idx > 0 && pq->data[idx]->frequency < pq->data[dad]->frequency) {
+    if (idx > 0 && queue_frequency(pq, idx) < queue_frequency(pq, dad)) {
         swap(&pq->data[idx], &pq->data[dad]);
         heapify_up(pq, dad);
     }
@@ -74,14 +96,14 @@ void heapify_up(PRIORITY_QUEUE* pq, int idx) {
     Reorganiza a heap quando um no é removido 
 */
 
-void heapify_down(PRIORITY_QUEUE* pq, int idx) {
+static inline void heapify_down(PRIORITY_QUEUE* pq, int idx) {
     int lower = idx;
     int left = 2 * idx + 1;
     int right = 2 * idx + 2;
 
-    if (left < pq->size && pq->data[left]->frequency < pq->data[lower]->frequency)
+    if (left < pq->size && queue_frequency(pq, left) < queue_frequency(pq, lower))
         lower = left;
-    if (right < pq->size && pq->data[right]->frequency < pq->data[lower]->frequency)
+    if (right < pq->size && queue_frequency(pq, right) < queue_frequency(pq, lower))
         lower = right;
 
     if (lower != idx) {
@@ -90,7 +112,7 @@ void heapify_down(PRIORITY_QUEUE* pq, int idx) {
     }
 }
 
-void insert(PRIORITY_QUEUE* pq, NODE* node) {
+static inline void insert(PRIORITY_QUEUE* pq, uint16_t node) {
     if (pq->size >= MAX_HEAP) {
         fprintf(stderr, "Error: Priority queue is full. Cannot insert new element.\n");
         return;
@@ -100,10 +122,10 @@ void insert(PRIORITY_QUEUE* pq, NODE* node) {
     pq->size++;
 }
 
-NODE* remove_lower(PRIORITY_QUEUE* pq) {
-    if (pq->size == 0) return NULL;
+static inline uint16_t remove_lower(PRIORITY_QUEUE* pq) {
+    if (pq->size == 0) return TREE_NIL;
 
-    NODE* min = pq->data[0];
+    uint16_t min = pq->data[0];
     pq->size--;
     pq->data[0] = pq->data[pq->size];
     heapify_down(pq, 0);
@@ -111,13 +133,202 @@ NODE* remove_lower(PRIORITY_QUEUE* pq) {
 }
 
 
-void free_priority_queue(PRIORITY_QUEUE* pq) {
-    if (pq == NULL) return;
+// Os nós pertencem à árvore; só a fila é liberada.
+static inline void free_priority_queue(PRIORITY_QUEUE* pq) {
+    free(pq);
+}
+
+
+/*
+    HEAP 4-ÁRIO GENÉRICO (crescente, com decrease-key)
+
+    Cada entrada guarda a chave ao lado de um identificador de 32 bits, que o
+    usuário associa ao que quiser (símbolo, tarefa, vértice de um grafo). Os
+    quatro filhos de um nó são vizinhos na memória (posições 4i+1 .. 4i+4): com
+    entradas de 16 bytes, são 64 bytes contíguos a partir do byte 64i + 16, ou
+    seja, no máximo duas linhas de cache vizinhas em vez de quatro ponteiros.
+
+    Com "indexed" ligado, position[id] guarda onde cada id está no vetor, o que
+    permite heap_decrease_key (Dijkstra, Prim, agendamento). Os ids devem ser
+    pequenos e únicos, pois indexam esse vetor.
+*/
+
+#define HEAP_ARITY 4
+#define HEAP_ABSENT UINT32_MAX
+
+typedef struct {
+    uint64_t key;
+    uint32_t id;
+} HEAP_ENTRY;
+
+typedef struct {
+    HEAP_ENTRY* data;
+    size_t size, capacity;
+    uint32_t* position;         // NULL quando o heap não é indexado
+    size_t position_capacity;
+} D_HEAP;
+
+static inline int heap_init(D_HEAP* heap, size_t capacity, int indexed) {
+    memset(heap, 0, sizeof(*heap));
+    if (capacity < HEAP_ARITY) capacity = HEAP_ARITY;
+
+    heap->data = malloc(capacity * sizeof(HEAP_ENTRY));
+    heap->capacity = capacity;
+    if (indexed) {
+        heap->position = malloc(capacity * sizeof(uint32_t));
+        heap->position_capacity = capacity;
+        if (heap->position) memset(heap->position, 0xFF, capacity * sizeof(uint32_t));
+    }
+
+    return heap->data && (!indexed || heap->position) ? 0 : -1;
+}
+
+static inline void heap_free(D_HEAP* heap) {
+    free(heap->data);
+    free(heap->position);
+    memset(heap, 0, sizeof(*heap));
+}
+
+static inline int heap_is_empty(const D_HEAP* heap) {
+    return heap->size == 0;
+}
+
+// Garante espaço para "size" entradas e para o id dado no índice de posições.
+static inline int heap_reserve(D_HEAP* heap, size_t size, uint32_t id) {
+    if (size > heap->capacity) {
+        size_t capacity = heap->capacity * 2 > size ? heap->capacity * 2 : size;
+        HEAP_ENTRY* data = realloc(heap->data, capacity * sizeof(HEAP_ENTRY));
+        if (!data) return -1;
+        heap->data = data;
+        heap->capacity = capacity;
+    }
+
+    if (heap->position && id != HEAP_ABSENT && id >= heap->position_capacity) {
+        size_t capacity = heap->position_capacity * 2 > (size_t)id + 1 ? heap->position_capacity * 2 : (size_t)id + 1;
+        uint32_t* position = realloc(heap->position, capacity * sizeof(uint32_t));
+        if (!position) return -1;
+        memset(position + heap->position_capacity, 0xFF, (capacity - heap->position_capacity) * sizeof(uint32_t));
+        heap->position = position;
+        heap->position_capacity = capacity;
+    }
+
+    return 0;
+}
+
+static inline void heap_place(D_HEAP* heap, size_t idx, HEAP_ENTRY entry) {
+    heap->data[idx] = entry;
+    if (heap->position) heap->position[entry.id] = (uint32_t)idx;
+}
+
+// Sobe a entrada da posição idx: os pais maiores descem até abrir o lugar dela.
+static inline void heap_sift_up(D_HEAP* heap, size_t idx) {
+    HEAP_ENTRY entry = heap->data[idx];
+
+    while (idx > 0) {
+        size_t parent = (idx - 1) / HEAP_ARITY;
+        if (heap->data[parent].key <= entry.key) break;
+        heap_place(heap, idx, heap->data[parent]);
+        idx = parent;
+    }
+    heap_place(heap, idx, entry);
+}
+
+// Desce a entrada da posição idx trocando-a pelo menor dos até quatro filhos.
+static inline void heap_sift_down(D_HEAP* heap, size_t idx) {
+    HEAP_ENTRY entry = heap->data[idx];
+    size_t size = heap->size;
+
+    for (;;) {
+        size_t first = idx * HEAP_ARITY + 1;
+        if (first >= size) break;
 
-    for (int i = 0; i < pq->size; i++) {
-        free_huffman_tree(pq->data[i]); // Libera cada nó na fila
+        size_t lower = first;
+        if (first + HEAP_ARITY <= size) {
+            // Caso comum, quatro filhos: dois torneios independentes e a final.
+            const HEAP_ENTRY* c = &heap->data[first];
+            size_t a = c[1].key < c[0].key ? 1 : 0;
+            size_t b = c[3].key < c[2].key ? 3 : 2;
+            lower = first + (c[b].key < c[a].key ? b : a);
+        } else {
+            for (size_t child = first + 1; child < size; child++) {
+                if (heap->data[child].key < heap->data[lower].key) lower = child;
+            }
+        }
+
+        if (heap->data[lower].key >= entry.key) break;
+        heap_place(heap, idx, heap->data[lower]);
+        idx = lower;
     }
-    free(pq); // FLibera a própria fila de prioridade
+    heap_place(heap, idx, entry);
+}
+
+// Insere uma entrada. Retorna -1 se faltar memória.
+static inline int heap_push(D_HEAP* heap, uint64_t key, uint32_t id) {
+    if (heap_reserve(heap, heap->size + 1, id) != 0) return -1;
+
+    heap->data[heap->size] = (HEAP_ENTRY){key, id};
+    heap_sift_up(heap, heap->size++);
+    return 0;
+}
+
+// Menor entrada, sem removê-la. O heap não pode estar vazio.
+static inline HEAP_ENTRY heap_top(const D_HEAP* heap) {
+    return heap->data[0];
+}
+
+// Remove a menor entrada e a copia para *out. Retorna -1 se o heap estiver vazio.
+static inline int heap_pop(D_HEAP* heap, HEAP_ENTRY* out) {
+    if (heap->size == 0) return -1;
+
+    *out = heap->data[0];
+    if (heap->position) heap->position[out->id] = HEAP_ABSENT;
+
+    if (--heap->size > 0) {
+        heap->data[0] = heap->data[heap->size];
+        heap_sift_down(heap, 0);
+    }
+    return 0;
+}
+
+// Substitui o conteúdo do heap por n entradas e o reorganiza de baixo para cima em O(n).
+static inline int heap_build(D_HEAP* heap, const HEAP_ENTRY* entries, size_t n) {
+    uint32_t max_id = 0;
+    for (size_t i = 0; heap->position && i < n; i++) {
+        if (entries[i].id > max_id) max_id = entries[i].id;
+    }
+    if (heap_reserve(heap, n, heap->position ? max_id : HEAP_ABSENT) != 0) return -1;
+
+    if (heap->position) {
+        for (size_t i = 0; i < heap->size; i++) heap->position[heap->data[i].id] = HEAP_ABSENT;
+    }
+
+    memcpy(heap->data, entries, n * sizeof(HEAP_ENTRY));
+    heap->size = n;
+    for (size_t i = 0; heap->position && i < n; i++) {
+        heap->position[entries[i].id] = (uint32_t)i;
+    }
+
+    for (size_t i = n > 1 ? (n - 2) / HEAP_ARITY + 1 : 0; i-- > 0;) {
+        heap_sift_down(heap, i);
+    }
+    return 0;
+}
+
+static inline int heap_contains(const D_HEAP* heap, uint32_t id) {
+    return heap->position && id < heap->position_capacity && heap->position[id] != HEAP_ABSENT;
+}
+
+// Diminui a chave de um id que está no heap (só em heaps indexados).
+// Retorna -1 se o id não estiver no heap ou se a nova chave for maior que a atual.
+static inline int heap_decrease_key(D_HEAP* heap, uint32_t id, uint64_t key) {
+    if (!heap_contains(heap, id)) return -1;
+
+    size_t idx = heap->position[id];
+    if (key > heap->data[idx].key) return -1;
+
+    heap->data[idx].key = key;
+    heap_sift_up(heap, idx);
+    return 0;
 }
 
 
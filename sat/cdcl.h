@@ -0,0 +1,886 @@
+#ifndef CDCL_H
+#define CDCL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "formula.h"
+#include "heap_variaveis.h"
+#include "compartilhamento.h"
+#include "drat.h"
+#include "estatisticas.h"
+
+/*
+    RESOLVEDOR CDCL (conflict-driven clause learning)
+
+    A busca mantém uma trilha com os literais atribuídos, em ordem, e para cada
+    variável o nível de decisão e a cláusula que a implicou (razão). Depois de
+    cada decisão, a propagação unitária atribui os literais forçados. Quando uma
+    cláusula fica falsa:
+        1. a análise de conflito resolve a cláusula com as razões dos literais do
+           nível atual até sobrar um único literal desse nível (primeiro UIP);
+        2. a cláusula resultante é aprendida: ela é falsa agora, mas vira unitária
+           assim que a busca volta ao segundo maior nível entre seus literais;
+        3. a busca salta direto para esse nível (retrocesso não cronológico) e a
+           propagação atribui o UIP negado.
+    As decisões seguem a atividade das variáveis (EVSIDS): cada variável que
+    aparece na análise de um conflito ganha um incremento, e o incremento cresce
+    1/DECAIMENTO_ATIVIDADE vezes por conflito, o que equivale a decair todas as
+    outras. A próxima decisão é a variável livre de maior atividade, tirada de um
+    heap; o retrocesso devolve ao heap as variáveis desatribuídas. A decisão usa o
+    último valor que a variável teve (fase salva), começando por falso.
+
+    Um conflito no nível 0 prova que a fórmula é insatisfatível. A busca recomeça
+    do nível 0 (reinício) segundo a sequência de Luby; as cláusulas aprendidas são
+    mantidas.
+
+    Propagação com dois literais observados: cada cláusula observa suas duas
+    primeiras posições, e a lista de observadores de um literal guarda as
+    cláusulas que o observam. Quando um literal fica falso, só essas cláusulas são
+    visitadas; cada uma procura outro literal não falso para observar e, se não
+    houver, o outro observado é forçado (ou a cláusula está em conflito). O
+    retrocesso não mexe nas listas: os observados continuam válidos porque são
+    desfeitos depois de qualquer literal atribuído mais tarde.
+
+    No modo portfólio (compartilhamento != NULL), várias instâncias resolvem a
+    mesma fórmula em threads diferentes: cada uma envia as cláusulas aprendidas
+    curtas pelo seu canal, recebe as das outras a cada reinício (no nível 0) e
+    para assim que alguma thread termina.
+
+    Uso incremental (sat.h): entre uma busca e outra podem entrar cláusulas e
+    variáveis novas (solver_adicionar_clausula, no nível 0), e a busca pode
+    receber suposições: literais decididos primeiro, um por nível. Se uma
+    suposição ficar falsa, analisar_final guarda em nucleo as suposições que a
+    tornaram falsa. Cláusulas aprendidas, atividades e fases continuam valendo
+    para as buscas seguintes, porque as suposições entram como decisões.
+
+    Com uma prova DRAT (prova != NULL, veja drat.h), cada cláusula aprendida é
+    gravada como adição e cada aprendida removida na redução como remoção; uma
+    cláusula que perde literais já falsos ao entrar (acrescentar_clausula) é
+    gravada já encurtada, e um conflito no nível 0 grava a cláusula vazia. A
+    prova só vale sem o portfólio, porque as cláusulas importadas de outra thread
+    não são consequência das cláusulas desta.
+
+    Com um Relatorio (relatorio != NULL, veja estatisticas.h), a busca imprime
+    uma linha de progresso periódica em stderr; o relógio só é consultado a
+    cada RELATORIO_CONFLITOS conflitos. solver_somar_contadores copia os
+    contadores para o relatório final.
+
+    REPRESENTAÇÃO
+    Dentro do resolvedor, a variável v vira os literais 2v (verdadeira) e 2v + 1
+    (falsa): a negação é um xor e o literal indexa direto os vetores por literal.
+    valor guarda um byte por literal (1 verdadeiro, 0 falso, -1 livre), de modo que
+    testar um literal é uma leitura, sem abs nem desvio pelo sinal. Só as funções
+    de entrada e saída (solver_adicionar_clausula, suposições, núcleo e
+    solver_modelo) usam os literais com sinal do DIMACS.
+
+    Todas as cláusulas ficam em um único vetor (arena), uma atrás da outra:
+    [tamanho, informações, literais...], e são referenciadas pela posição. Cada
+    observador guarda, além da cláusula, um literal dela (bloqueador): se ele já
+    for verdadeiro, a cláusula está satisfeita sem que a arena seja lida. Nas
+    cláusulas binárias o bloqueador é o outro literal, e a propagação nunca lê a
+    arena (ela continua lá para a análise de conflito).
+
+    A cada REDUCAO_INTERVALO conflitos (intervalo que cresce REDUCAO_INCREMENTO),
+    metade das cláusulas aprendidas sai: as de maior LBD (número de níveis de
+    decisão distintos entre os literais quando foram aprendidas). Ficam as de LBD
+    até LBD_PERMANENTE, as que são razão de alguma atribuição e as que participaram
+    de um conflito desde a última redução. Depois a arena é compactada a partir
+    da primeira cláusula removida: as vivas são reescritas em sequência e os
+    observadores e as razões passam para as posições novas.
+*/
+
+#define CLAUSULA_NENHUMA -1
+
+#define RESULTADO_INSATISFATIVEL 0
+#define RESULTADO_SATISFATIVEL 1
+#define RESULTADO_INTERROMPIDO -1   // outra thread do portfólio terminou antes
+#define REINICIO_BASE 100       // conflitos da primeira rodada; as seguintes seguem Luby
+#define REINICIO_FATOR 1.5       // razão dos reinícios geométricos (diversificação do portfólio)
+#define DECAIMENTO_ATIVIDADE 0.95
+#define LIMITE_ATIVIDADE 1e100  // acima disso todas as atividades são reescaladas
+
+#define CABECALHO_CLAUSULA 2    // tamanho e informações, antes dos literais
+#define CLAUSULA_REMOVIDA 1     // bits da palavra de informações; o LBD fica acima deles
+#define CLAUSULA_APRENDIDA 2
+#define CLAUSULA_USADA 4
+#define LBD_DESLOCAMENTO 3
+#define REDUCAO_INTERVALO 2000
+#define REDUCAO_INCREMENTO 300
+#define LBD_PERMANENTE 2        // aprendidas com LBD até esse valor nunca são removidas
+
+typedef struct {
+    int* itens;
+    int tamanho;
+    int capacidade;
+} ListaInt;
+
+typedef struct {
+    int bloqueador;             // outro literal da cláusula (nas binárias, o único outro)
+    unsigned clausula : 31;     // posição na arena
+    unsigned binaria : 1;
+} Observador;
+
+typedef struct {
+    Observador* itens;
+    int tamanho;
+    int capacidade;
+} ListaObservadores;
+
+typedef struct {
+    int num_variaveis;
+    int* arena;                 // cláusulas: [tamanho, informações, literais...]
+    int tamanho_arena;
+    int capacidade_arena;
+    int desperdicio;            // palavras de cláusulas removidas ainda na arena
+    int num_originais;
+    ListaInt aprendidas;        // posições das cláusulas aprendidas na arena
+    long proxima_reducao;       // número de conflitos em que a próxima redução acontece
+
+    signed char* valor;         // por literal: 1 verdadeiro, 0 falso, -1 livre
+    int* nivel;                 // nível de decisão de cada variável
+    int* razao;                 // cláusula que implicou a variável (CLAUSULA_NENHUMA = decisão)
+    int* trilha;                // literais verdadeiros, na ordem em que foram atribuídos
+    int tamanho_trilha;
+    int propagados;             // literais da trilha cujas consequências já foram propagadas
+    int* inicio_nivel;          // posição da trilha onde cada nível começa
+    int* nivel_visto;           // por nível, o último conflito em que apareceu (cálculo do LBD)
+    int capacidade_niveis;
+    int nivel_atual;
+    bool inconsistente;         // conflito no nível 0: insatisfatível para sempre
+
+    const int* suposicoes;      // literais assumidos na busca atual (com sinal)
+    int num_suposicoes;
+    ListaInt nucleo;            // suposições responsáveis pela última resposta insatisfatível
+
+    ListaObservadores* observadores;    // por literal: cláusulas que o observam
+    char* marcado;              // variáveis vistas na análise de conflito
+    int* aprendida;             // cláusula em construção na análise
+    ListaInt conversao;         // literais convertidos em solver_adicionar_clausula
+
+    double* atividade;          // atividade de cada variável (EVSIDS)
+    double incremento_atividade;
+    char* fase;                 // último valor de cada variável, usado na próxima decisão
+    HeapVariaveis ordem;        // variáveis livres (e algumas atribuídas) por atividade
+
+    bool reinicio_geometrico;   // REINICIO_BASE * REINICIO_FATOR^k em vez de Luby
+
+    Compartilhamento* compartilhamento;     // NULL fora do modo portfólio
+    int id;                     // número da thread no portfólio
+    unsigned long* cursores;    // posição de leitura no canal de cada thread
+
+    ProvaDrat* prova;           // NULL sem prova DRAT
+    Relatorio* relatorio;       // NULL sem linha de progresso
+
+    long decisoes, propagacoes, conflitos, reinicios, importadas;
+    long reducoes, removidas;
+    long aprendizados;          // cláusulas aprendidas, inclusive unitárias e já removidas
+} Solver;
+
+static inline void lista_adicionar(ListaInt* lista, int valor) {
+    if (lista->tamanho == lista->capacidade) {
+        lista->capacidade = lista->capacidade ? 2 * lista->capacidade : 4;
+        lista->itens = (int*)realloc(lista->itens, lista->capacidade * sizeof(int));
+    }
+    lista->itens[lista->tamanho++] = valor;
+}
+
+static inline void observar(Solver* s, int literal, int bloqueador, int clausula, bool binaria) {
+    ListaObservadores* lista = &s->observadores[literal];
+    if (lista->tamanho == lista->capacidade) {
+        lista->capacidade = lista->capacidade ? 2 * lista->capacidade : 4;
+        lista->itens = (Observador*)realloc(lista->itens, lista->capacidade * sizeof(Observador));
+    }
+    lista->itens[lista->tamanho++] = (Observador){bloqueador, (unsigned)clausula, binaria};
+}
+
+static inline int codificar_literal(int literal) {
+    return literal > 0 ? 2 * literal : -2 * literal + 1;
+}
+
+static inline int decodificar_literal(int literal) {
+    return literal & 1 ? -(literal >> 1) : literal >> 1;
+}
+
+static inline int variavel_de(int literal) {
+    return literal >> 1;
+}
+
+static inline int negacao(int literal) {
+    return literal ^ 1;
+}
+
+static inline int* literais_clausula(const Solver* s, int clausula) {
+    return s->arena + clausula + CABECALHO_CLAUSULA;
+}
+
+static inline int tamanho_clausula(const Solver* s, int clausula) {
+    return s->arena[clausula];
+}
+
+// Guarda uma cláusula na arena (já sem literais repetidos, com ao menos dois) e
+// passa a observar suas duas primeiras posições. Retorna a posição.
+static inline int adicionar_clausula(Solver* s, const int* literais, int num_literais, bool aprendida, int lbd) {
+    int necessario = s->tamanho_arena + CABECALHO_CLAUSULA + num_literais;
+    if (necessario > s->capacidade_arena) {
+        while (s->capacidade_arena < necessario) s->capacidade_arena = s->capacidade_arena ? 2 * s->capacidade_arena : 1024;
+        s->arena = (int*)realloc(s->arena, s->capacidade_arena * sizeof(int));
+    }
+
+    int clausula = s->tamanho_arena;
+    s->arena[clausula] = num_literais;
+    s->arena[clausula + 1] = (aprendida ? CLAUSULA_APRENDIDA : 0) | lbd << LBD_DESLOCAMENTO;
+    memcpy(literais_clausula(s, clausula), literais, num_literais * sizeof(int));
+    s->tamanho_arena = necessario;
+
+    observar(s, literais[0], literais[1], clausula, num_literais == 2);
+    observar(s, literais[1], literais[0], clausula, num_literais == 2);
+    if (aprendida) lista_adicionar(&s->aprendidas, clausula);
+    else s->num_originais++;
+    return clausula;
+}
+
+static inline void atribuir(Solver* s, int literal, int razao) {
+    int v = variavel_de(literal);
+    s->valor[literal] = 1;
+    s->valor[negacao(literal)] = 0;
+    s->nivel[v] = s->nivel_atual;
+    s->razao[v] = razao;
+    s->trilha[s->tamanho_trilha++] = literal;
+}
+
+static inline void aumentar_atividade(Solver* s, int v) {
+    s->atividade[v] += s->incremento_atividade;
+    if (s->atividade[v] > LIMITE_ATIVIDADE) {
+        // Reescala tudo de uma vez; a ordem relativa (e portanto o heap) não muda.
+        for (int i = 1; i <= s->num_variaveis; i++) s->atividade[i] *= 1 / LIMITE_ATIVIDADE;
+        s->incremento_atividade *= 1 / LIMITE_ATIVIDADE;
+    }
+    heap_variaveis_aumentou(&s->ordem, v);
+}
+
+// Propaga os literais ainda não processados da trilha. Retorna a cláusula em
+// conflito ou CLAUSULA_NENHUMA.
+static inline int propagar(Solver* s) {
+    while (s->propagados < s->tamanho_trilha) {
+        int falso = negacao(s->trilha[s->propagados++]);
+        ListaObservadores* lista = &s->observadores[falso];
+        Observador* lido = lista->itens;
+        Observador* mantido = lista->itens;
+        Observador* fim = lista->itens + lista->tamanho;
+        s->propagacoes++;
+
+        while (lido < fim) {
+            Observador o = *lido++;
+            int valor_bloqueador = s->valor[o.bloqueador];
+            if (valor_bloqueador == 1) {
+                *mantido++ = o;
+                continue;
+            }
+            if (o.binaria) {
+                *mantido++ = o;
+                if (valor_bloqueador == 0) goto conflito;
+                atribuir(s, o.bloqueador, o.clausula);
+                continue;
+            }
+
+            // O literal falso fica na posição 1; a posição 0 é o outro observado.
+            int* literais = literais_clausula(s, o.clausula);
+            int num_literais = tamanho_clausula(s, o.clausula);
+            if (literais[0] == falso) {
+                literais[0] = literais[1];
+                literais[1] = falso;
+            }
+            o.bloqueador = literais[0];
+            if (s->valor[literais[0]] == 1) {
+                *mantido++ = o;
+                continue;
+            }
+
+            // Procura um substituto não falso; se achar, a cláusula sai desta lista.
+            int i = 2;
+            while (i < num_literais && s->valor[literais[i]] == 0) i++;
+            if (i < num_literais) {
+                literais[1] = literais[i];
+                literais[i] = falso;
+                observar(s, literais[1], literais[0], o.clausula, false);
+                continue;
+            }
+
+            *mantido++ = o;
+            if (s->valor[literais[0]] == 0) goto conflito;
+            atribuir(s, literais[0], o.clausula);
+            continue;
+
+        conflito:
+            // Mantém o resto da lista e descarta o que falta propagar.
+            while (lido < fim) *mantido++ = *lido++;
+            lista->tamanho = (int)(mantido - lista->itens);
+            s->propagados = s->tamanho_trilha;
+            return o.clausula;
+        }
+        lista->tamanho = (int)(mantido - lista->itens);
+    }
+    return CLAUSULA_NENHUMA;
+}
+
+// Desfaz as atribuições dos níveis acima de "nivel".
+static inline void retroceder(Solver* s, int nivel) {
+    if (s->nivel_atual <= nivel) return;
+
+    for (int i = s->tamanho_trilha - 1; i >= s->inicio_nivel[nivel + 1]; i--) {
+        int literal = s->trilha[i];
+        int v = variavel_de(literal);
+        s->fase[v] = (char)(1 - (literal & 1));
+        s->valor[literal] = -1;
+        s->valor[negacao(literal)] = -1;
+        heap_variaveis_inserir(&s->ordem, v);
+    }
+    s->tamanho_trilha = s->inicio_nivel[nivel + 1];
+    s->propagados = s->tamanho_trilha;
+    s->nivel_atual = nivel;
+}
+
+// Análise de conflito pelo primeiro UIP. Monta a cláusula aprendida em s->aprendida
+// (o UIP negado na posição 0 e um literal do nível de retorno na posição 1) e
+// retorna seu tamanho; *nivel_retorno recebe o nível para onde a busca deve saltar.
+static inline int analisar_conflito(Solver* s, int conflito, int* nivel_retorno) {
+    int tamanho = 1, pendentes = 0, literal = -1;
+    int posicao = s->tamanho_trilha - 1;
+    int clausula = conflito;
+
+    do {
+        const int* literais = literais_clausula(s, clausula);
+        int num_literais = tamanho_clausula(s, clausula);
+        if (s->arena[clausula + 1] & CLAUSULA_APRENDIDA) s->arena[clausula + 1] |= CLAUSULA_USADA;
+
+        for (int i = 0; i < num_literais; i++) {
+            int q = literais[i];
+            int v = variavel_de(q);
+            if (q == literal || s->marcado[v] || s->nivel[v] == 0) continue;
+
+            s->marcado[v] = 1;
+            aumentar_atividade(s, v);
+            if (s->nivel[v] == s->nivel_atual) pendentes++;
+            else s->aprendida[tamanho++] = q;
+        }
+
+        // Próximo literal marcado do nível atual, andando para trás na trilha.
+        while (!s->marcado[variavel_de(s->trilha[posicao])]) posicao--;
+        literal = s->trilha[posicao--];
+        clausula = s->razao[variavel_de(literal)];
+        s->marcado[variavel_de(literal)] = 0;
+        pendentes--;
+    } while (pendentes > 0);
+
+    s->aprendida[0] = negacao(literal);
+    s->incremento_atividade /= DECAIMENTO_ATIVIDADE;
+
+    // O literal de maior nível (depois do UIP) vai para a posição 1.
+    *nivel_retorno = 0;
+    for (int i = 1; i < tamanho; i++) {
+        int v = variavel_de(s->aprendida[i]);
+        s->marcado[v] = 0;
+        if (s->nivel[v] > *nivel_retorno) {
+            *nivel_retorno = s->nivel[v];
+            int troca = s->aprendida[1];
+            s->aprendida[1] = s->aprendida[i];
+            s->aprendida[i] = troca;
+        }
+    }
+    return tamanho;
+}
+
+// Número de níveis de decisão distintos entre os literais (LBD).
+static inline int calcular_lbd(Solver* s, const int* literais, int num_literais) {
+    int carimbo = (int)s->conflitos;
+    int lbd = 0;
+    for (int i = 0; i < num_literais; i++) {
+        int nivel = s->nivel[variavel_de(literais[i])];
+        if (s->nivel_visto[nivel] != carimbo) {
+            s->nivel_visto[nivel] = carimbo;
+            lbd++;
+        }
+    }
+    return lbd;
+}
+
+// i-ésimo termo (a partir de 0) da sequência de Luby: 1 1 2 1 1 2 4 1 1 2 ...
+static inline long luby(long i) {
+    long tamanho = 1, expoente = 0;
+    while (tamanho < i + 1) {
+        tamanho = 2 * tamanho + 1;
+        expoente++;
+    }
+    while (tamanho - 1 != i) {
+        tamanho = (tamanho - 1) / 2;
+        expoente--;
+        i = i % tamanho;
+    }
+    return 1L << expoente;
+}
+
+// Variável livre de maior atividade, ou -1 se todas estiverem atribuídas. As
+// variáveis atribuídas que ainda estão no heap são descartadas no caminho.
+static inline int escolher_variavel(Solver* s) {
+    while (s->ordem.tamanho > 0) {
+        int v = heap_variaveis_remover_maximo(&s->ordem);
+        if (s->valor[2 * v] == -1) return v;
+    }
+    return -1;
+}
+
+// Compacta a arena a partir de "inicio" (a primeira cláusula removida): o trecho
+// é copiado para um vetor temporário e as cláusulas vivas voltam em sequência.
+// Tudo antes de "inicio" (em geral as originais) fica no lugar, e o vetor
+// temporário só tem o tamanho do trecho. Na cópia, o tamanho de cada cláusula
+// viva é trocado pela sua posição nova, usada para atualizar observadores,
+// razões e a lista de aprendidas.
+static inline void coletar_lixo(Solver* s, int inicio) {
+    int trecho = s->tamanho_arena - inicio;
+    int* copia = (int*)malloc(trecho * sizeof(int));
+    memcpy(copia, s->arena + inicio, trecho * sizeof(int));
+
+    int tamanho = inicio;
+    for (int c = 0; c < trecho;) {
+        int ocupado = CABECALHO_CLAUSULA + copia[c];
+        if (!(copia[c + 1] & CLAUSULA_REMOVIDA)) {
+            memcpy(s->arena + tamanho, copia + c, ocupado * sizeof(int));
+            copia[c] = tamanho;
+            tamanho += ocupado;
+        }
+        c += ocupado;
+    }
+
+    for (int literal = 2; literal <= 2 * s->num_variaveis + 1; literal++) {
+        ListaObservadores* lista = &s->observadores[literal];
+        int mantidos = 0;
+        for (int k = 0; k < lista->tamanho; k++) {
+            Observador o = lista->itens[k];
+            if ((int)o.clausula >= inicio) {
+                const int* antiga = copia + (o.clausula - inicio);
+                if (antiga[1] & CLAUSULA_REMOVIDA) continue;
+                o.clausula = (unsigned)antiga[0];
+            }
+            lista->itens[mantidos++] = o;
+        }
+        lista->tamanho = mantidos;
+    }
+    for (int i = 0; i < s->tamanho_trilha; i++) {
+        int v = variavel_de(s->trilha[i]);
+        if (s->razao[v] >= inicio) s->razao[v] = copia[s->razao[v] - inicio];
+    }
+    int mantidas = 0;
+    for (int i = 0; i < s->aprendidas.tamanho; i++) {
+        int c = s->aprendidas.itens[i];
+        if (c < inicio) s->aprendidas.itens[mantidas++] = c;
+        else if (!(copia[c - inicio + 1] & CLAUSULA_REMOVIDA)) s->aprendidas.itens[mantidas++] = copia[c - inicio];
+    }
+    s->aprendidas.tamanho = mantidas;
+
+    free(copia);
+    s->tamanho_arena = tamanho;
+    s->desperdicio = 0;
+}
+
+// Uma cláusula travada é razão de alguma atribuição. A propagação das cláusulas longas
+// e o aprendizado põem o literal implicado na posição 0; as binárias são propagadas
+// pelo observador sem reordenar os literais, então o implicado pode ser qualquer um dos dois.
+static inline bool clausula_travada(const Solver* s, int clausula) {
+    const int* literais = literais_clausula(s, clausula);
+    int candidatos = tamanho_clausula(s, clausula) == 2 ? 2 : 1;
+    for (int i = 0; i < candidatos; i++) {
+        if (s->valor[literais[i]] == 1 && s->razao[variavel_de(literais[i])] == clausula) return true;
+    }
+    return false;
+}
+
+// Chave de ordenação para a remoção: LBD, depois tamanho, depois a posição.
+static inline uint64_t chave_remocao(const Solver* s, int clausula) {
+    uint64_t lbd = (uint64_t)(s->arena[clausula + 1] >> LBD_DESLOCAMENTO);
+    uint64_t tamanho = (uint64_t)s->arena[clausula];
+    if (lbd > 0xFFFF) lbd = 0xFFFF;
+    if (tamanho > 0xFFFF) tamanho = 0xFFFF;
+    return lbd << 47 | tamanho << 31 | (uint64_t)clausula;
+}
+
+// Maior chave primeiro.
+static inline int comparar_chaves(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x < y) - (x > y);
+}
+
+// Remove metade das aprendidas candidatas (veja o comentário do início) e compacta a arena.
+static inline void reduzir_aprendidas(Solver* s) {
+    uint64_t* candidatas = (uint64_t*)malloc((s->aprendidas.tamanho + 1) * sizeof(uint64_t));
+    int num_candidatas = 0;
+    for (int i = 0; i < s->aprendidas.tamanho; i++) {
+        int c = s->aprendidas.itens[i];
+        int informacoes = s->arena[c + 1];
+        if (informacoes & CLAUSULA_USADA) {
+            s->arena[c + 1] = informacoes & ~CLAUSULA_USADA;
+            continue;
+        }
+        if ((informacoes >> LBD_DESLOCAMENTO) <= LBD_PERMANENTE || clausula_travada(s, c)) continue;
+        candidatas[num_candidatas++] = chave_remocao(s, c);
+    }
+
+    qsort(candidatas, num_candidatas, sizeof(uint64_t), comparar_chaves);
+    int primeira = s->tamanho_arena;
+    for (int i = 0; i < num_candidatas / 2; i++) {
+        int c = (int)(candidatas[i] & 0x7FFFFFFF);
+        if (s->prova) drat_clausula(s->prova, 'd', literais_clausula(s, c), tamanho_clausula(s, c));
+        s->arena[c + 1] |= CLAUSULA_REMOVIDA;
+        s->desperdicio += CABECALHO_CLAUSULA + s->arena[c];
+        if (c < primeira) primeira = c;
+    }
+    s->removidas += num_candidatas / 2;
+    s->reducoes++;
+    free(candidatas);
+    if (s->desperdicio > 0) coletar_lixo(s, primeira);
+}
+
+static inline void solver_liberar(Solver* s) {
+    for (int literal = 0; literal <= 2 * s->num_variaveis + 1; literal++) free(s->observadores[literal].itens);
+    free(s->arena);
+    free(s->aprendidas.itens);
+    free(s->observadores);
+    free(s->valor);
+    free(s->nivel);
+    free(s->razao);
+    free(s->trilha);
+    free(s->inicio_nivel);
+    free(s->nivel_visto);
+    free(s->marcado);
+    free(s->aprendida);
+    free(s->conversao.itens);
+    free(s->atividade);
+    free(s->fase);
+    free(s->cursores);
+    free(s->nucleo.itens);
+    heap_variaveis_liberar(&s->ordem);
+}
+
+// Amplia as estruturas indexadas por variável ou literal para n variáveis; as
+// novas ficam livres, com atividade 0, e entram no heap.
+static inline void solver_ampliar(Solver* s, int n) {
+    int primeira = s->valor ? s->num_variaveis + 1 : 0;
+    if (primeira > n) return;
+
+    s->valor = (signed char*)realloc(s->valor, 2 * (n + 1));
+    s->observadores = (ListaObservadores*)realloc(s->observadores, 2 * (n + 1) * sizeof(ListaObservadores));
+    s->nivel = (int*)realloc(s->nivel, (n + 1) * sizeof(int));
+    s->razao = (int*)realloc(s->razao, (n + 1) * sizeof(int));
+    s->trilha = (int*)realloc(s->trilha, (n + 1) * sizeof(int));
+    s->marcado = (char*)realloc(s->marcado, n + 1);
+    s->aprendida = (int*)realloc(s->aprendida, (n + 1) * sizeof(int));
+    s->atividade = (double*)realloc(s->atividade, (n + 1) * sizeof(double));
+    s->fase = (char*)realloc(s->fase, n + 1);
+    memset(s->valor + 2 * primeira, -1, 2 * (n + 1 - primeira));
+    memset(s->observadores + 2 * primeira, 0, 2 * (n + 1 - primeira) * sizeof(ListaObservadores));
+    for (int v = primeira; v <= n; v++) {
+        s->nivel[v] = 0;
+        s->razao[v] = CLAUSULA_NENHUMA;
+        s->marcado[v] = 0;
+        s->atividade[v] = 0;
+        s->fase[v] = 0;
+    }
+
+    s->ordem.itens = (int*)realloc(s->ordem.itens, (n + 1) * sizeof(int));
+    s->ordem.posicao = (int*)realloc(s->ordem.posicao, (n + 1) * sizeof(int));
+    s->ordem.atividade = s->atividade;
+    for (int v = primeira; v <= n; v++) s->ordem.posicao[v] = HEAP_FORA;
+
+    s->num_variaveis = n;
+    for (int v = primeira > 0 ? primeira : 1; v <= n; v++) heap_variaveis_inserir(&s->ordem, v);
+}
+
+// Acrescenta uma cláusula (literais codificados) no nível 0: tira literais
+// repetidos e os já falsos, descarta tautologias e cláusulas já satisfeitas e
+// atribui as unitárias. Retorna false se a fórmula ficou insatisfatível
+// (cláusula vazia).
+static inline bool acrescentar_clausula(Solver* s, const int* literais, int num_literais, bool aprendida) {
+    if (s->inconsistente) return false;
+
+    // s->marcado guarda o sinal já visto de cada variável: 1 positivo, 2 negativo.
+    int tamanho = 0;
+    bool descartar = false;
+    for (int i = 0; i < num_literais; i++) {
+        int q = literais[i];
+        int sinal = 1 + (q & 1);
+        if (s->marcado[variavel_de(q)] == sinal) continue;
+        if (s->marcado[variavel_de(q)] != 0 || s->valor[q] == 1) {
+            descartar = true;
+            break;
+        }
+        s->marcado[variavel_de(q)] = (char)sinal;
+        s->aprendida[tamanho++] = q;
+    }
+    for (int i = 0; i < tamanho; i++) s->marcado[variavel_de(s->aprendida[i])] = 0;
+    if (descartar) return true;
+
+    int livres = 0;
+    for (int i = 0; i < tamanho; i++) {
+        if (s->valor[s->aprendida[i]] == -1) s->aprendida[livres++] = s->aprendida[i];
+    }
+    if (s->prova && livres < tamanho) drat_clausula(s->prova, 'a', s->aprendida, livres);
+
+    if (livres == 0) {
+        s->inconsistente = true;
+        return false;
+    }
+    if (livres == 1) atribuir(s, s->aprendida[0], CLAUSULA_NENHUMA);
+    else adicionar_clausula(s, s->aprendida, livres, aprendida, livres);
+    return true;
+}
+
+// Versão de acrescentar_clausula para literais com sinal (DIMACS). Variáveis
+// novas ampliam o resolvedor.
+static inline bool solver_adicionar_clausula(Solver* s, const int* literais, int num_literais) {
+    int maior = 0;
+    s->conversao.tamanho = 0;
+    for (int i = 0; i < num_literais; i++) {
+        if (abs(literais[i]) > maior) maior = abs(literais[i]);
+        lista_adicionar(&s->conversao, codificar_literal(literais[i]));
+    }
+    if (maior > s->num_variaveis) solver_ampliar(s, maior);
+    return acrescentar_clausula(s, s->conversao.itens, num_literais, false);
+}
+
+// Copia as cláusulas da fórmula (veja acrescentar_clausula). Retorna false se a
+// fórmula for trivialmente insatisfatível (cláusula vazia ou unitárias
+// contraditórias). A prova pode ser NULL.
+static inline bool solver_iniciar(Solver* s, const Formula* formula, ProvaDrat* prova) {
+    memset(s, 0, sizeof(*s));
+    s->prova = prova;
+    s->incremento_atividade = 1;
+    s->proxima_reducao = REDUCAO_INTERVALO;
+    heap_variaveis_iniciar(&s->ordem, 0, NULL);
+    solver_ampliar(s, formula->num_variaveis);
+
+    // Reserva a arena de uma vez: as cláusulas originais ocupam no máximo isso.
+    long palavras = 0;
+    for (int i = 0; i < formula->num_clausulas; i++) palavras += CABECALHO_CLAUSULA + formula->clausulas[i].num_literais;
+    s->capacidade_arena = (int)(palavras + palavras / 2 + 1024);
+    s->arena = (int*)malloc(s->capacidade_arena * sizeof(int));
+
+    for (int i = 0; i < formula->num_clausulas; i++) {
+        const Clausula* c = &formula->clausulas[i];
+        if (!solver_adicionar_clausula(s, c->literais, c->num_literais)) break;
+    }
+    return !s->inconsistente;
+}
+
+// Copia o valor das variáveis 1 a modelo->num_variaveis (-1 livre, 0 falso, 1 verdadeiro).
+static inline void solver_modelo(const Solver* s, Interpretacao* modelo) {
+    for (int v = 1; v <= modelo->num_variaveis; v++) {
+        modelo->valores[v] = v <= s->num_variaveis ? s->valor[2 * v] : -1;
+    }
+}
+
+// Guarda em s->nucleo as suposições que, com as cláusulas, forçam "falsa" a ser
+// falsa (incluindo a própria "falsa"). Anda para trás na trilha a partir das
+// razões, como a análise de conflito; as decisões encontradas são suposições.
+static inline void analisar_final(Solver* s, int falsa) {
+    s->nucleo.tamanho = 0;
+    lista_adicionar(&s->nucleo, decodificar_literal(falsa));
+    if (s->nivel[variavel_de(falsa)] == 0) return;
+
+    s->marcado[variavel_de(falsa)] = 1;
+    for (int i = s->tamanho_trilha - 1; i >= s->inicio_nivel[1]; i--) {
+        int v = variavel_de(s->trilha[i]);
+        if (!s->marcado[v]) continue;
+
+        if (s->razao[v] == CLAUSULA_NENHUMA) {
+            lista_adicionar(&s->nucleo, decodificar_literal(s->trilha[i]));
+        } else {
+            const int* literais = literais_clausula(s, s->razao[v]);
+            int num_literais = tamanho_clausula(s, s->razao[v]);
+            for (int j = 0; j < num_literais; j++) {
+                if (s->nivel[variavel_de(literais[j])] > 0) s->marcado[variavel_de(literais[j])] = 1;
+            }
+        }
+        s->marcado[v] = 0;
+    }
+}
+
+// Configura a instância "id" do portfólio. A 0 mantém a busca padrão; as demais
+// variam a política de reinício, a fase inicial e a ordem inicial das variáveis.
+static inline void solver_diversificar(Solver* s, int id, Compartilhamento* compartilhamento) {
+    s->compartilhamento = compartilhamento;
+    s->id = id;
+    s->cursores = (unsigned long*)calloc(compartilhamento->num_threads, sizeof(unsigned long));
+    if (id == 0) return;
+
+    s->reinicio_geometrico = id % 2 == 1;
+    uint64_t estado = 0x9E3779B97F4A7C15ull * (uint64_t)(id + 1);
+    for (int v = 1; v <= s->num_variaveis; v++) {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        // Atividades iniciais pequenas e distintas: só mudam a ordem até os primeiros conflitos.
+        s->atividade[v] = (double)(estado >> 11) / (double)(1ull << 53) * 1e-3;
+        if (id % 3 == 1) s->fase[v] = 1;
+        else if (id % 3 == 2) s->fase[v] = (char)(estado & 1);
+    }
+
+    heap_variaveis_esvaziar(&s->ordem);
+    for (int v = 1; v <= s->num_variaveis; v++) {
+        if (s->valor[2 * v] == -1) heap_variaveis_inserir(&s->ordem, v);
+    }
+}
+
+static inline long limite_reinicio(const Solver* s, long rodada) {
+    if (!s->reinicio_geometrico) return REINICIO_BASE * luby(rodada);
+
+    double limite = REINICIO_BASE;
+    for (long i = 0; i < rodada && limite < 1e15; i++) limite *= REINICIO_FATOR;
+    return (long)limite;
+}
+
+// Acrescenta as cláusulas recebidas das outras threads (no nível 0, depois de um
+// reinício). Entram como aprendidas, com LBD igual ao tamanho. Retorna false se
+// alguma cláusula ficar vazia: a fórmula é insatisfatível.
+static inline bool importar_clausulas(Solver* s) {
+    int literais[COMPARTILHAR_MAX_TAMANHO];
+
+    for (int origem = 0; origem < s->compartilhamento->num_threads; origem++) {
+        if (origem == s->id) continue;
+
+        int tamanho;
+        while ((tamanho = receber_clausula(s->compartilhamento, origem, &s->cursores[origem], literais)) >= 0) {
+            if (tamanho == 0) continue;
+            s->importadas++;
+            if (!acrescentar_clausula(s, literais, tamanho, true)) return false;
+        }
+    }
+    return true;
+}
+
+// Linha de progresso, se já passou o intervalo do relatório.
+static inline void solver_progresso(Solver* s) {
+    double decorrido;
+    if (!relatorio_progresso_devido(s->relatorio, &decorrido)) return;
+    double busca = decorrido - s->relatorio->tempo_fase[FASE_LEITURA] - s->relatorio->tempo_fase[FASE_PREPROCESSAMENTO];
+    fprintf(stderr, "c progresso: %.1f s, %ld conflitos (%.0f/s), %ld decisões, %.2f M propagações/s, "
+                    "%ld reinícios, %d aprendidas vivas, %ld removidas, trilha no nível 0: %d\n",
+            decorrido, s->conflitos, busca > 0 ? s->conflitos / busca : 0.0, s->decisoes,
+            busca > 0 ? s->propagacoes / busca / 1e6 : 0.0, s->reinicios, s->aprendidas.tamanho, s->removidas,
+            s->nivel_atual > 0 ? s->inicio_nivel[1] : s->tamanho_trilha);
+}
+
+// Soma os contadores da busca aos do relatório (no portfólio, uma vez por thread).
+static inline void solver_somar_contadores(const Solver* s, Relatorio* r) {
+    r->decisoes += s->decisoes;
+    r->propagacoes += s->propagacoes;
+    r->conflitos += s->conflitos;
+    r->reinicios += s->reinicios;
+    r->aprendidas += s->aprendizados;
+    r->removidas += s->removidas;
+    r->reducoes += s->reducoes;
+    r->importadas += s->importadas;
+}
+
+// Laço principal do CDCL, sob as suposições em s->suposicoes. Retorna
+// RESULTADO_SATISFATIVEL com a atribuição completa em s->valor,
+// RESULTADO_INSATISFATIVEL (com as suposições culpadas em s->nucleo; vazio se a
+// fórmula for insatisfatível por si só) ou, no portfólio, RESULTADO_INTERROMPIDO
+// se outra thread terminou antes.
+static inline int solver_buscar(Solver* s) {
+    // A sequência de reinícios recomeça a cada busca: no uso incremental, uma
+    // consulta nova não deve herdar os intervalos longos do fim da anterior.
+    long rodada = 0;
+    long limite = limite_reinicio(s, rodada);
+    long conflitos_rodada = 0;
+
+    s->nucleo.tamanho = 0;
+    retroceder(s, 0);
+    if (s->inconsistente) return RESULTADO_INSATISFATIVEL;
+
+    // Cada suposição pode ocupar um nível, além das decisões comuns.
+    if (s->capacidade_niveis < s->num_variaveis + s->num_suposicoes + 2) {
+        int anterior = s->capacidade_niveis;
+        s->capacidade_niveis = s->num_variaveis + s->num_suposicoes + 2;
+        s->inicio_nivel = (int*)realloc(s->inicio_nivel, s->capacidade_niveis * sizeof(int));
+        s->nivel_visto = (int*)realloc(s->nivel_visto, s->capacidade_niveis * sizeof(int));
+        for (int i = anterior; i < s->capacidade_niveis; i++) s->nivel_visto[i] = -1;
+    }
+
+    while (true) {
+        int conflito = propagar(s);
+
+        if (conflito != CLAUSULA_NENHUMA) {
+            s->conflitos++;
+            conflitos_rodada++;
+            if (s->nivel_atual == 0) {
+                if (s->prova) drat_clausula(s->prova, 'a', NULL, 0);
+                s->inconsistente = true;
+                return RESULTADO_INSATISFATIVEL;
+            }
+            if (s->compartilhamento && busca_cancelada(s->compartilhamento)) return RESULTADO_INTERROMPIDO;
+            if (s->relatorio && (s->conflitos & (RELATORIO_CONFLITOS - 1)) == 0) solver_progresso(s);
+
+            int nivel_retorno;
+            int tamanho = analisar_conflito(s, conflito, &nivel_retorno);
+            int lbd = calcular_lbd(s, s->aprendida, tamanho);
+            retroceder(s, nivel_retorno);
+            if (s->prova) drat_clausula(s->prova, 'a', s->aprendida, tamanho);
+            s->aprendizados++;
+
+            if (s->compartilhamento && tamanho <= COMPARTILHAR_MAX_TAMANHO) {
+                compartilhar_clausula(s->compartilhamento, s->id, s->aprendida, tamanho);
+            }
+            if (tamanho == 1) {
+                atribuir(s, s->aprendida[0], CLAUSULA_NENHUMA);
+            } else {
+                atribuir(s, s->aprendida[0], adicionar_clausula(s, s->aprendida, tamanho, true, lbd));
+            }
+            continue;
+        }
+
+        if (conflitos_rodada >= limite) {
+            s->reinicios++;
+            conflitos_rodada = 0;
+            limite = limite_reinicio(s, ++rodada);
+            retroceder(s, 0);
+            if (s->compartilhamento && !importar_clausulas(s)) return RESULTADO_INSATISFATIVEL;
+            continue;
+        }
+
+        if (s->conflitos >= s->proxima_reducao) {
+            s->proxima_reducao = s->conflitos + REDUCAO_INTERVALO + s->reducoes * REDUCAO_INCREMENTO;
+            reduzir_aprendidas(s);
+        }
+
+        // As suposições são decididas primeiro, a de índice i no nível i + 1. Uma
+        // suposição já verdadeira ganha um nível vazio, para manter essa relação.
+        int decisao = -1;
+        while (decisao == -1 && s->nivel_atual < s->num_suposicoes) {
+            int suposicao = codificar_literal(s->suposicoes[s->nivel_atual]);
+            if (s->valor[suposicao] == 0) {
+                analisar_final(s, suposicao);
+                return RESULTADO_INSATISFATIVEL;
+            }
+            if (s->valor[suposicao] == -1) {
+                decisao = suposicao;
+            } else {
+                s->nivel_atual++;
+                s->inicio_nivel[s->nivel_atual] = s->tamanho_trilha;
+            }
+        }
+        if (decisao == -1) {
+            int variavel = escolher_variavel(s);
+            if (variavel == -1) return RESULTADO_SATISFATIVEL;
+            decisao = s->fase[variavel] ? 2 * variavel : 2 * variavel + 1;
+        }
+
+        s->decisoes++;
+        s->nivel_atual++;
+        s->inicio_nivel[s->nivel_atual] = s->tamanho_trilha;
+        atribuir(s, decisao, CLAUSULA_NENHUMA);
+    }
+}
+
+#endif // CDCL_H
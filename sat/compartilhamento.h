@@ -0,0 +1,101 @@
+#ifndef COMPARTILHAMENTO_H
+#define COMPARTILHAMENTO_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/*
+    TROCA DE CLÁUSULAS APRENDIDAS ENTRE THREADS (modo portfólio)
+
+    Cada thread tem um canal de saída: um anel com CANAL_CAPACIDADE posições em
+    que só ela escreve (um produtor), e cada thread lê os canais das outras com
+    o próprio cursor. Nada usa trava:
+        - a escritora marca a posição como "em escrita" (sequência ímpar), grava os
+          literais e publica com a sequência par 2 * (número da cláusula + 1);
+        - a leitora confere a sequência antes e depois de copiar os literais; se
+          mudou, a posição foi reescrita no meio da cópia e a cláusula é descartada.
+    Uma leitora lenta que fica mais de CANAL_CAPACIDADE cláusulas para trás perde
+    as mais antigas, o que é aceitável: compartilhar é só uma ajuda à busca.
+
+    O mesmo bloco guarda o sinal de término: a primeira thread que termina grava
+    seu número em "vencedora" e as outras param no próximo conflito.
+*/
+
+#define CANAL_CAPACIDADE 4096
+#define COMPARTILHAR_MAX_TAMANHO 8      // só cláusulas aprendidas até esse tamanho são enviadas
+
+typedef struct {
+    atomic_ulong sequencia;
+    atomic_int tamanho;
+    atomic_int literais[COMPARTILHAR_MAX_TAMANHO];
+} PosicaoCanal;
+
+typedef struct {
+    PosicaoCanal posicoes[CANAL_CAPACIDADE];
+    atomic_ulong escritas;      // cláusulas já publicadas neste canal
+} CanalClausulas;
+
+typedef struct {
+    int num_threads;
+    CanalClausulas* canais;     // um por thread
+    atomic_int vencedora;       // -1 enquanto nenhuma thread terminou
+} Compartilhamento;
+
+static inline void compartilhamento_iniciar(Compartilhamento* c, int num_threads) {
+    c->num_threads = num_threads;
+    c->canais = (CanalClausulas*)calloc(num_threads, sizeof(CanalClausulas));
+    atomic_init(&c->vencedora, -1);
+}
+
+static inline void compartilhamento_liberar(Compartilhamento* c) {
+    free(c->canais);
+}
+
+// Publica uma cláusula no canal da thread "origem" (só ela chama esta função).
+static inline void compartilhar_clausula(Compartilhamento* c, int origem, const int* literais, int tamanho) {
+    CanalClausulas* canal = &c->canais[origem];
+    unsigned long numero = atomic_load_explicit(&canal->escritas, memory_order_relaxed);
+    PosicaoCanal* p = &canal->posicoes[numero % CANAL_CAPACIDADE];
+
+    atomic_store_explicit(&p->sequencia, 2 * numero + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&p->tamanho, tamanho, memory_order_relaxed);
+    for (int i = 0; i < tamanho; i++) atomic_store_explicit(&p->literais[i], literais[i], memory_order_relaxed);
+    atomic_store_explicit(&p->sequencia, 2 * numero + 2, memory_order_release);
+    atomic_store_explicit(&canal->escritas, numero + 1, memory_order_release);
+}
+
+// Copia a próxima cláusula do canal "origem" a partir de *cursor. Retorna o
+// tamanho, 0 se a posição foi reescrita durante a cópia (a cláusula se perdeu)
+// ou -1 se não houver cláusula nova.
+static inline int receber_clausula(Compartilhamento* c, int origem, unsigned long* cursor, int* literais) {
+    CanalClausulas* canal = &c->canais[origem];
+    unsigned long escritas = atomic_load_explicit(&canal->escritas, memory_order_acquire);
+    if (*cursor >= escritas) return -1;
+    if (escritas - *cursor > CANAL_CAPACIDADE) *cursor = escritas - CANAL_CAPACIDADE;
+
+    unsigned long numero = (*cursor)++;
+    PosicaoCanal* p = &canal->posicoes[numero % CANAL_CAPACIDADE];
+    if (atomic_load_explicit(&p->sequencia, memory_order_acquire) != 2 * numero + 2) return 0;
+
+    int tamanho = atomic_load_explicit(&p->tamanho, memory_order_relaxed);
+    if (tamanho < 1 || tamanho > COMPARTILHAR_MAX_TAMANHO) return 0;
+    for (int i = 0; i < tamanho; i++) literais[i] = atomic_load_explicit(&p->literais[i], memory_order_relaxed);
+
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&p->sequencia, memory_order_relaxed) != 2 * numero + 2) return 0;
+    return tamanho;
+}
+
+// Registra a thread como vencedora. Retorna false se outra já tinha terminado.
+static inline bool declarar_vencedora(Compartilhamento* c, int id) {
+    int nenhuma = -1;
+    return atomic_compare_exchange_strong(&c->vencedora, &nenhuma, id);
+}
+
+static inline bool busca_cancelada(Compartilhamento* c) {
+    return atomic_load_explicit(&c->vencedora, memory_order_relaxed) != -1;
+}
+
+#endif // COMPARTILHAMENTO_H
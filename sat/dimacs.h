@@ -0,0 +1,242 @@
+#ifndef DIMACS_H
+#define DIMACS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "formula.h"
+
+/*
+    LEITURA DE DIMACS CNF
+
+    O arquivo inteiro fica em memória de uma vez: arquivos regulares são mapeados
+    com mmap (sem cópia), e pipes ou a entrada padrão ("-") são lidos em blocos
+    grandes com read. Os inteiros são lidos por um laço próprio, sem fscanf, e
+    todos os literais vão para um único vetor (Formula.literais); cada cláusula
+    aponta para o seu trecho dele, sem um malloc por cláusula.
+
+    Aceita:
+        - comentários ("c ...") em qualquer lugar, inclusive depois de "p cnf";
+        - cláusulas quebradas em várias linhas ou várias por linha, com espaços,
+          tabulações ou \r\n;
+        - a última cláusula sem o 0 final e o "%" que encerra os arquivos do SATLIB;
+        - contagens do cabeçalho diferentes das reais (valem as reais; a diferença
+          só gera um aviso).
+    Qualquer outro conteúdo é erro, com o número da linha.
+*/
+
+#define DIMACS_BLOCO_LEITURA (1 << 20)
+
+typedef struct {
+    const char* inicio;
+    const char* p;
+    const char* fim;
+    const char* nome_arquivo;
+} LeitorDimacs;
+
+static inline void erro_dimacs(const LeitorDimacs* leitor, const char* mensagem) {
+    long linha = 1;
+    for (const char* q = leitor->inicio; q < leitor->p; q++) linha += *q == '\n';
+    printf("Erro em %s, linha %ld: %s\n", leitor->nome_arquivo, linha, mensagem);
+    exit(1);
+}
+
+static inline void pular_linha(LeitorDimacs* leitor) {
+    const char* quebra = memchr(leitor->p, '\n', leitor->fim - leitor->p);
+    leitor->p = quebra ? quebra + 1 : leitor->fim;
+}
+
+// Pula espaços e comentários. Retorna false no fim do arquivo.
+static inline bool pular_espacos(LeitorDimacs* leitor) {
+    const char* p = leitor->p;
+    while (p < leitor->fim) {
+        unsigned char ch = (unsigned char)*p;
+        if (ch == ' ' || (ch >= '\t' && ch <= '\r')) {
+            p++;
+        } else if (ch == 'c') {
+            leitor->p = p;
+            pular_linha(leitor);
+            p = leitor->p;
+        } else {
+            leitor->p = p;
+            return true;
+        }
+    }
+    leitor->p = p;
+    return false;
+}
+
+// Lê um inteiro com sinal opcional (|valor| <= INT_MAX) na posição atual.
+static inline int ler_inteiro(LeitorDimacs* leitor) {
+    const char* p = leitor->p;
+    bool negativo = p < leitor->fim && *p == '-';
+    if (negativo) p++;
+    if (p == leitor->fim || (unsigned)(*p - '0') > 9) erro_dimacs(leitor, "esperava um número");
+
+    long valor = 0;
+    while (p < leitor->fim && (unsigned)(*p - '0') <= 9) {
+        valor = valor * 10 + (*p++ - '0');
+        if (valor > INT_MAX) erro_dimacs(leitor, "número grande demais");
+    }
+    if (p < leitor->fim && !(*p == ' ' || (*p >= '\t' && *p <= '\r'))) {
+        leitor->p = p;
+        erro_dimacs(leitor, "caractere inesperado");
+    }
+    leitor->p = p;
+    return negativo ? -(int)valor : (int)valor;
+}
+
+// Lê "p cnf VARIAVEIS CLAUSULAS"; leitor->p está no 'p'.
+static inline void ler_cabecalho(LeitorDimacs* leitor, int* variaveis, int* clausulas) {
+    leitor->p++;
+    while (leitor->p < leitor->fim && (*leitor->p == ' ' || *leitor->p == '\t')) leitor->p++;
+    if (leitor->fim - leitor->p < 3 || memcmp(leitor->p, "cnf", 3) != 0) {
+        erro_dimacs(leitor, "cabeçalho deve ser \"p cnf VARIAVEIS CLAUSULAS\"");
+    }
+    leitor->p += 3;
+    pular_espacos(leitor);
+    *variaveis = ler_inteiro(leitor);
+    pular_espacos(leitor);
+    *clausulas = ler_inteiro(leitor);
+    if (*variaveis < 0 || *clausulas < 0) erro_dimacs(leitor, "contagens negativas no cabeçalho");
+}
+
+// Lê todo o descritor em um buffer alocado (para pipes e entrada padrão).
+static inline char* ler_descritor(int fd, size_t* tamanho) {
+    size_t capacidade = DIMACS_BLOCO_LEITURA;
+    char* dados = (char*)malloc(capacidade);
+    *tamanho = 0;
+
+    while (dados != NULL) {
+        if (capacidade - *tamanho < DIMACS_BLOCO_LEITURA) {
+            capacidade *= 2;
+            char* maior = (char*)realloc(dados, capacidade);
+            if (maior == NULL) break;
+            dados = maior;
+        }
+        ssize_t lidos = read(fd, dados + *tamanho, capacidade - *tamanho);
+        if (lidos == 0) return dados;
+        if (lidos < 0) break;
+        *tamanho += (size_t)lidos;
+    }
+    free(dados);
+    return NULL;
+}
+
+// Interpreta o conteúdo de um arquivo DIMACS já em memória.
+static inline Formula interpretar_dimacs(const char* dados, size_t tamanho, const char* nome_arquivo) {
+    LeitorDimacs leitor = {dados, dados, dados + tamanho, nome_arquivo};
+    Formula F;
+    int variaveis_cabecalho = 0, clausulas_cabecalho = 0;
+
+    if (!pular_espacos(&leitor) || *leitor.p != 'p') {
+        erro_dimacs(&leitor, "cabeçalho \"p cnf\" ausente");
+    }
+    ler_cabecalho(&leitor, &variaveis_cabecalho, &clausulas_cabecalho);
+
+    // Tamanhos iniciais pelo cabeçalho; os dois vetores dobram se ele estiver errado.
+    size_t capacidade_literais = (size_t)clausulas_cabecalho * 4 + 16;
+    size_t capacidade_inicios = (size_t)clausulas_cabecalho + 2;
+    int* literais = (int*)malloc(capacidade_literais * sizeof(int));
+    size_t* inicios = (size_t*)malloc(capacidade_inicios * sizeof(size_t));
+    size_t num_literais = 0, num_clausulas = 0;
+    int maior_variavel = 0;
+    bool clausula_aberta = false;
+    if (literais == NULL || inicios == NULL) erro_dimacs(&leitor, "memória insuficiente");
+
+    while (pular_espacos(&leitor)) {
+        if (*leitor.p == '%') break;
+        if (*leitor.p == 'p') erro_dimacs(&leitor, "cabeçalho repetido");
+
+        int literal = ler_inteiro(&leitor);
+        if (!clausula_aberta) {
+            if (num_clausulas + 1 >= capacidade_inicios) {
+                capacidade_inicios *= 2;
+                inicios = (size_t*)realloc(inicios, capacidade_inicios * sizeof(size_t));
+                if (inicios == NULL) erro_dimacs(&leitor, "memória insuficiente");
+            }
+            inicios[num_clausulas] = num_literais;
+            clausula_aberta = true;
+        }
+        if (literal == 0) {
+            num_clausulas++;
+            clausula_aberta = false;
+            continue;
+        }
+
+        if (num_literais == capacidade_literais) {
+            capacidade_literais *= 2;
+            literais = (int*)realloc(literais, capacidade_literais * sizeof(int));
+            if (literais == NULL) erro_dimacs(&leitor, "memória insuficiente");
+        }
+        literais[num_literais++] = literal;
+        if (abs(literal) > maior_variavel) maior_variavel = abs(literal);
+    }
+    if (clausula_aberta) num_clausulas++;
+    inicios[num_clausulas] = num_literais;
+
+    if ((size_t)clausulas_cabecalho != num_clausulas) {
+        fprintf(stderr, "Aviso: o cabeçalho anuncia %d cláusulas, o arquivo tem %zu\n",
+                clausulas_cabecalho, num_clausulas);
+    }
+    if (maior_variavel > variaveis_cabecalho) {
+        fprintf(stderr, "Aviso: o cabeçalho anuncia %d variáveis, o arquivo usa até %d\n",
+                variaveis_cabecalho, maior_variavel);
+    }
+
+    // Só agora os ponteiros das cláusulas são fixados: o vetor de literais não muda mais de lugar.
+    F.literais = literais;
+    F.num_clausulas = (int)num_clausulas;
+    F.num_variaveis = maior_variavel > variaveis_cabecalho ? maior_variavel : variaveis_cabecalho;
+    F.clausulas = (Clausula*)malloc((num_clausulas + 1) * sizeof(Clausula));
+    for (size_t i = 0; i < num_clausulas; i++) {
+        F.clausulas[i].literais = literais + inicios[i];
+        F.clausulas[i].num_literais = (int)(inicios[i + 1] - inicios[i]);
+    }
+    free(inicios);
+    return F;
+}
+
+// Lê um arquivo DIMACS CNF ("-" é a entrada padrão) e guarda em *bytes o tamanho
+// lido (se bytes não for NULL). Em caso de erro, imprime a causa e encerra.
+static inline Formula ler_dimacs(const char* nome_arquivo, size_t* bytes) {
+    bool entrada_padrao = strcmp(nome_arquivo, "-") == 0;
+    int fd = entrada_padrao ? STDIN_FILENO : open(nome_arquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
+        exit(1);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* mapa = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            posix_madvise(mapa, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            if (bytes) *bytes = (size_t)st.st_size;
+            Formula F = interpretar_dimacs((const char*)mapa, (size_t)st.st_size, nome_arquivo);
+            munmap(mapa, (size_t)st.st_size);
+            if (!entrada_padrao) close(fd);
+            return F;
+        }
+    }
+
+    size_t tamanho;
+    char* dados = ler_descritor(fd, &tamanho);
+    if (!entrada_padrao) close(fd);
+    if (dados == NULL) {
+        printf("Erro ao ler o arquivo %s\n", nome_arquivo);
+        exit(1);
+    }
+    if (bytes) *bytes = tamanho;
+    Formula F = interpretar_dimacs(dados, tamanho, nome_arquivo);
+    free(dados);
+    return F;
+}
+
+#endif // DIMACS_H
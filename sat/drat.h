@@ -0,0 +1,109 @@
+#ifndef DRAT_H
+#define DRAT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+    PROVA DRAT EM FORMATO BINÁRIO
+
+    Cada passo da prova é um byte 'a' (cláusula adicionada) ou 'd' (removida),
+    seguido dos literais e de um byte 0. O literal v vira 2v e o literal -v vira
+    2v + 1 (a mesma codificação usada dentro de cdcl.h), escritos em base 128 com
+    os 7 bits menos significativos primeiro e o bit 0x80 indicando que há mais
+    bytes. É o formato binário aceito pelo drat-trim e por verificador_drat.c.
+
+    Cada cláusula adicionada precisa ser consequência por propagação unitária
+    (RUP) das cláusulas vivas naquele ponto; remoções não precisam de
+    justificativa. Os passos vão para um buffer de DRAT_BUFFER bytes, gravado
+    com write quando enche, de modo que a prova custa poucas chamadas de sistema.
+*/
+
+#define DRAT_BUFFER (1 << 20)
+#define DRAT_MAX_BYTES_LITERAL 5        // um inteiro de 32 bits em base 128
+
+typedef struct {
+    int fd;
+    unsigned char* buffer;
+    size_t usado;
+    bool falhou;                // alguma escrita falhou; o resto da prova é descartado
+    long adicionadas, removidas;
+    unsigned long long bytes;
+} ProvaDrat;
+
+// Abre (ou cria) o arquivo da prova. Retorna false se não conseguir.
+static inline bool drat_abrir(ProvaDrat* prova, const char* caminho) {
+    prova->fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    prova->buffer = (unsigned char*)malloc(DRAT_BUFFER);
+    prova->usado = 0;
+    prova->falhou = prova->fd < 0 || prova->buffer == NULL;
+    prova->adicionadas = prova->removidas = 0;
+    prova->bytes = 0;
+    return !prova->falhou;
+}
+
+static inline void drat_esvaziar(ProvaDrat* prova) {
+    size_t escritos = 0;
+    while (escritos < prova->usado && !prova->falhou) {
+        ssize_t n = write(prova->fd, prova->buffer + escritos, prova->usado - escritos);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) prova->falhou = true;
+        else escritos += (size_t)n;
+    }
+    prova->bytes += prova->usado;
+    prova->usado = 0;
+}
+
+static inline void drat_byte(ProvaDrat* prova, unsigned char byte) {
+    if (prova->usado == DRAT_BUFFER) drat_esvaziar(prova);
+    prova->buffer[prova->usado++] = byte;
+}
+
+// Um literal codificado em base 128; só confere o espaço livre uma vez.
+static inline void drat_numero(ProvaDrat* prova, unsigned u) {
+    if (DRAT_BUFFER - prova->usado < DRAT_MAX_BYTES_LITERAL) drat_esvaziar(prova);
+    while (u > 0x7F) {
+        prova->buffer[prova->usado++] = (unsigned char)(0x80 | (u & 0x7F));
+        u >>= 7;
+    }
+    prova->buffer[prova->usado++] = (unsigned char)u;
+}
+
+// Grava um passo com literais já codificados (2v / 2v + 1).
+static inline void drat_clausula(ProvaDrat* prova, char tipo, const int* literais, int num_literais) {
+    if (prova->falhou) return;
+    drat_byte(prova, (unsigned char)tipo);
+    for (int i = 0; i < num_literais; i++) {
+        drat_numero(prova, (unsigned)literais[i]);
+    }
+    drat_byte(prova, 0);
+    if (tipo == 'a') prova->adicionadas++;
+    else prova->removidas++;
+}
+
+// Mesmo passo, com literais com sinal (DIMACS).
+static inline void drat_clausula_dimacs(ProvaDrat* prova, char tipo, const int* literais, int num_literais) {
+    if (prova->falhou) return;
+    drat_byte(prova, (unsigned char)tipo);
+    for (int i = 0; i < num_literais; i++) {
+        drat_numero(prova, literais[i] > 0 ? 2u * (unsigned)literais[i] : 2u * (unsigned)-literais[i] + 1);
+    }
+    drat_byte(prova, 0);
+    if (tipo == 'a') prova->adicionadas++;
+    else prova->removidas++;
+}
+
+// Grava o que falta e fecha o arquivo. Retorna false se alguma escrita falhou.
+static inline bool drat_fechar(ProvaDrat* prova) {
+    drat_esvaziar(prova);
+    if (prova->fd >= 0 && close(prova->fd) != 0) prova->falhou = true;
+    free(prova->buffer);
+    prova->buffer = NULL;
+    return !prova->falhou;
+}
+
+#endif // DRAT_H
@@ -0,0 +1,119 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+/*
+    ESTATÍSTICAS DA EXECUÇÃO
+
+    Relatorio junta o tempo de cada fase (leitura, pré-processamento, busca), os
+    números do pré-processamento e os contadores da busca (decisões,
+    propagações, conflitos, reinícios, cláusulas aprendidas e removidas). Serve
+    a dois usos, ambos opcionais:
+        - uma linha de progresso em stderr a cada "intervalo" segundos durante a
+          busca (solver_progresso em cdcl.h);
+        - um relatório final em JSON (relatorio_escrever_json).
+
+    Os contadores são os que o resolvedor já mantém; só são copiados para cá no
+    fim. Sem linha de progresso, o resolvedor nem recebe o Relatorio (ponteiro
+    NULL, testado uma vez por conflito); com ela, o relógio é lido só a cada
+    RELATORIO_CONFLITOS conflitos.
+*/
+
+#define RELATORIO_CONFLITOS 256     // potência de 2: conflitos entre duas leituras do relógio
+
+enum { FASE_LEITURA, FASE_PREPROCESSAMENTO, FASE_BUSCA, NUM_FASES };
+
+static const char* const NOMES_FASES[NUM_FASES] = {"leitura", "preprocessamento", "busca"};
+
+typedef struct {
+    double inicio;
+    double intervalo;           // segundos entre linhas de progresso (0: nenhuma)
+    double proximo_progresso;
+    double inicio_fase;
+    double tempo_fase[NUM_FASES];
+
+    const char* arquivo;
+    const char* resultado;
+    int variaveis, clausulas, threads;
+
+    bool preprocessado;
+    int clausulas_simplificada, fixadas, puras, eliminadas, subsumidas, fortalecidas;
+
+    long decisoes, propagacoes, conflitos, reinicios, aprendidas, removidas, reducoes, importadas;
+} Relatorio;
+
+static inline double relatorio_agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static inline void relatorio_iniciar(Relatorio* r, double intervalo) {
+    memset(r, 0, sizeof(*r));
+    r->inicio = relatorio_agora();
+    r->intervalo = intervalo;
+    r->proximo_progresso = r->inicio + intervalo;
+    r->resultado = "INDEFINIDO";
+}
+
+static inline void relatorio_comecar_fase(Relatorio* r) {
+    r->inicio_fase = relatorio_agora();
+}
+
+// Soma ao tempo da fase o que passou desde relatorio_comecar_fase. Retorna esse tempo.
+static inline double relatorio_terminar_fase(Relatorio* r, int fase) {
+    double segundos = relatorio_agora() - r->inicio_fase;
+    r->tempo_fase[fase] += segundos;
+    return segundos;
+}
+
+// Se já é hora de uma linha de progresso, agenda a próxima e guarda em
+// *decorrido os segundos desde o início.
+static inline bool relatorio_progresso_devido(Relatorio* r, double* decorrido) {
+    double t = relatorio_agora();
+    if (r->intervalo <= 0 || t < r->proximo_progresso) return false;
+    while (r->proximo_progresso <= t) r->proximo_progresso += r->intervalo;
+    *decorrido = t - r->inicio;
+    return true;
+}
+
+// Uma string JSON: aspas, barras e caracteres de controle escapados.
+static inline void escrever_string_json(FILE* f, const char* texto) {
+    fputc('"', f);
+    for (const unsigned char* p = (const unsigned char*)texto; *p; p++) {
+        if (*p == '"' || *p == '\\') fprintf(f, "\\%c", *p);
+        else if (*p < 0x20) fprintf(f, "\\u%04x", *p);
+        else fputc(*p, f);
+    }
+    fputc('"', f);
+}
+
+static inline void relatorio_escrever_json(const Relatorio* r, FILE* f) {
+    fprintf(f, "{\n  \"arquivo\": ");
+    escrever_string_json(f, r->arquivo ? r->arquivo : "");
+    fprintf(f, ",\n  \"resultado\": \"%s\",\n", r->resultado);
+    fprintf(f, "  \"variaveis\": %d,\n  \"clausulas\": %d,\n  \"threads\": %d,\n", r->variaveis, r->clausulas, r->threads);
+
+    fprintf(f, "  \"tempo\": {");
+    for (int fase = 0; fase < NUM_FASES; fase++) fprintf(f, "\"%s\": %.6f, ", NOMES_FASES[fase], r->tempo_fase[fase]);
+    fprintf(f, "\"total\": %.6f},\n", relatorio_agora() - r->inicio);
+
+    if (r->preprocessado) {
+        fprintf(f, "  \"preprocessamento\": {\"clausulas\": %d, \"fixadas\": %d, \"puras\": %d, \"eliminadas\": %d, "
+                   "\"subsumidas\": %d, \"fortalecidas\": %d},\n",
+                r->clausulas_simplificada, r->fixadas, r->puras, r->eliminadas, r->subsumidas, r->fortalecidas);
+    } else {
+        fprintf(f, "  \"preprocessamento\": null,\n");
+    }
+
+    fprintf(f, "  \"busca\": {\"decisoes\": %ld, \"propagacoes\": %ld, \"conflitos\": %ld, \"reinicios\": %ld, "
+               "\"aprendidas\": %ld, \"removidas\": %ld, \"reducoes\": %ld, \"importadas\": %ld}\n}\n",
+            r->decisoes, r->propagacoes, r->conflitos, r->reinicios, r->aprendidas, r->removidas, r->reducoes,
+            r->importadas);
+}
+
+#endif // ESTATISTICAS_H
@@ -0,0 +1,39 @@
+#ifndef FORMULA_H
+#define FORMULA_H
+
+#include <stdlib.h>
+
+/*
+    Tipos básicos de uma fórmula em CNF.
+
+    Um literal é um inteiro com sinal, como no DIMACS: v é a variável v
+    verdadeira e -v é a variável v falsa (variáveis de 1 a num_variaveis).
+    Na fórmula lida do DIMACS, os literais de todas as cláusulas ficam em um
+    único vetor (literais) e cada Clausula aponta para o seu trecho.
+    Em Interpretacao.valores, -1 = livre, 0 = falso e 1 = verdadeiro.
+*/
+
+typedef struct {
+    int* literais;
+    int num_literais;
+} Clausula;
+
+typedef struct {
+    Clausula* clausulas;
+    int* literais;              // dono da memória apontada pelas cláusulas
+    int num_clausulas;
+    int num_variaveis;
+} Formula;
+
+typedef struct {
+    int* valores;
+    int num_variaveis;
+} Interpretacao;
+
+// Libera uma fórmula cujas cláusulas apontam para o vetor literais (leitura do DIMACS, pré-processamento).
+static inline void liberar_formula(Formula* F) {
+    free(F->literais);
+    free(F->clausulas);
+}
+
+#endif // FORMULA_H
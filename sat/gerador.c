@@ -0,0 +1,120 @@
+/*
+    Gerador de instâncias DIMACS CNF reproduzíveis, no estilo das competições de SAT.
+
+    Compila com: gcc -O2 gerador.c -o gerador
+    Uso:
+        ./gerador aleatorio VARIAVEIS CLAUSULAS K SEMENTE   k-SAT aleatório (razão 4,26 com K = 3 é a mais difícil)
+        ./gerador pombos N                                  N + 1 pombos em N casas (sempre UNSAT)
+        ./gerador coloracao VERTICES ARESTAS CORES SEMENTE  coloração de um grafo aleatório
+    A fórmula é escrita na saída padrão.
+
+    As instâncias de benchmarks/ foram geradas com:
+        ./gerador aleatorio 150 639 3 1    > benchmarks/uf150-01.cnf
+        ./gerador aleatorio 200 852 3 7    > benchmarks/uf200-07.cnf
+        ./gerador aleatorio 250 1065 3 3   > benchmarks/uf250-03.cnf
+        ./gerador aleatorio 150 675 3 2    > benchmarks/uuf150-02.cnf
+        ./gerador pombos 7                 > benchmarks/pombos7.cnf
+        ./gerador coloracao 120 400 4 5    > benchmarks/cor120-4.cnf
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Gerador xorshift: a mesma semente gera a mesma fórmula em qualquer máquina.
+static uint64_t proximo_aleatorio(uint64_t* estado) {
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static uint64_t iniciar_estado(long semente) {
+    uint64_t estado = 0x9E3779B97F4A7C15ull ^ (uint64_t)semente * 0xBF58476D1CE4E5B9ull;
+    for (int i = 0; i < 8; i++) proximo_aleatorio(&estado);
+    return estado;
+}
+
+// Cada cláusula tem K variáveis distintas, cada uma com sinal aleatório.
+static void gerar_aleatorio(int variaveis, int clausulas, int k, long semente) {
+    uint64_t estado = iniciar_estado(semente);
+    int* escolhidas = malloc(k * sizeof(int));
+
+    printf("c k-SAT aleatório: %d variáveis, %d cláusulas, k = %d, semente %ld\n", variaveis, clausulas, k, semente);
+    printf("p cnf %d %d\n", variaveis, clausulas);
+    for (int c = 0; c < clausulas; c++) {
+        for (int i = 0; i < k; i++) {
+            int v, repetida;
+            do {
+                v = 1 + (int)(proximo_aleatorio(&estado) % variaveis);
+                repetida = 0;
+                for (int j = 0; j < i; j++) {
+                    if (escolhidas[j] == v) repetida = 1;
+                }
+            } while (repetida);
+            escolhidas[i] = v;
+            printf("%d ", (proximo_aleatorio(&estado) & 1) ? v : -v);
+        }
+        printf("0\n");
+    }
+    free(escolhidas);
+}
+
+// Variável p(i, j) = pombo i na casa j. Todo pombo ocupa uma casa e nenhuma casa tem dois pombos.
+static void gerar_pombos(int casas) {
+    int pombos = casas + 1;
+    int clausulas = pombos + casas * pombos * (pombos - 1) / 2;
+
+    printf("c princípio da casa dos pombos: %d pombos em %d casas\n", pombos, casas);
+    printf("p cnf %d %d\n", pombos * casas, clausulas);
+    for (int i = 0; i < pombos; i++) {
+        for (int j = 0; j < casas; j++) printf("%d ", i * casas + j + 1);
+        printf("0\n");
+    }
+    for (int j = 0; j < casas; j++) {
+        for (int a = 0; a < pombos; a++) {
+            for (int b = a + 1; b < pombos; b++) {
+                printf("-%d -%d 0\n", a * casas + j + 1, b * casas + j + 1);
+            }
+        }
+    }
+}
+
+// Variável x(v, c) = vértice v tem a cor c. Cada vértice tem ao menos uma cor e
+// vértices vizinhos não compartilham cor.
+static void gerar_coloracao(int vertices, int arestas, int cores, long semente) {
+    uint64_t estado = iniciar_estado(semente);
+
+    printf("c coloração de grafo aleatório: %d vértices, %d arestas, %d cores, semente %ld\n",
+           vertices, arestas, cores, semente);
+    printf("p cnf %d %d\n", vertices * cores, vertices + arestas * cores);
+    for (int v = 0; v < vertices; v++) {
+        for (int c = 0; c < cores; c++) printf("%d ", v * cores + c + 1);
+        printf("0\n");
+    }
+    for (int e = 0; e < arestas; e++) {
+        int a = (int)(proximo_aleatorio(&estado) % vertices);
+        int b = (int)(proximo_aleatorio(&estado) % (vertices - 1));
+        if (b >= a) b++;
+        for (int c = 0; c < cores; c++) {
+            printf("-%d -%d 0\n", a * cores + c + 1, b * cores + c + 1);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 6 && strcmp(argv[1], "aleatorio") == 0 && atoi(argv[2]) >= atoi(argv[4]) && atoi(argv[4]) > 0) {
+        gerar_aleatorio(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]), atol(argv[5]));
+    } else if (argc == 3 && strcmp(argv[1], "pombos") == 0 && atoi(argv[2]) > 0) {
+        gerar_pombos(atoi(argv[2]));
+    } else if (argc == 6 && strcmp(argv[1], "coloracao") == 0 && atoi(argv[2]) > 1 && atoi(argv[4]) > 0) {
+        gerar_coloracao(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]), atol(argv[5]));
+    } else {
+        fprintf(stderr, "Uso: %s aleatorio VARIAVEIS CLAUSULAS K SEMENTE\n"
+                        "     %s pombos N\n"
+                        "     %s coloracao VERTICES ARESTAS CORES SEMENTE\n", argv[0], argv[0], argv[0]);
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#ifndef HEAP_VARIAVEIS_H
+#define HEAP_VARIAVEIS_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+/*
+    Heap binário de máximo sobre as variáveis, ordenado pela atividade de cada uma.
+
+    A atividade fica fora do heap (no resolvedor); o heap guarda só os índices
+    das variáveis e, em posicao, onde cada uma está (-1 = fora do heap). Assim
+    dá para saber em O(1) se uma variável está no heap e subir uma variável cuja
+    atividade aumentou sem procurá-la.
+*/
+
+#define HEAP_FORA -1
+
+typedef struct {
+    int* itens;                 // variáveis, com a de maior atividade em itens[0]
+    int* posicao;               // posição de cada variável em itens, ou HEAP_FORA
+    int tamanho;
+    const double* atividade;    // indexada pela variável
+} HeapVariaveis;
+
+static inline void heap_variaveis_iniciar(HeapVariaveis* heap, int num_variaveis, const double* atividade) {
+    heap->itens = (int*)malloc((num_variaveis + 1) * sizeof(int));
+    heap->posicao = (int*)malloc((num_variaveis + 1) * sizeof(int));
+    for (int v = 0; v <= num_variaveis; v++) heap->posicao[v] = HEAP_FORA;
+    heap->tamanho = 0;
+    heap->atividade = atividade;
+}
+
+static inline void heap_variaveis_liberar(HeapVariaveis* heap) {
+    free(heap->itens);
+    free(heap->posicao);
+}
+
+static inline void heap_variaveis_esvaziar(HeapVariaveis* heap) {
+    for (int i = 0; i < heap->tamanho; i++) heap->posicao[heap->itens[i]] = HEAP_FORA;
+    heap->tamanho = 0;
+}
+
+static inline bool heap_variaveis_contem(const HeapVariaveis* heap, int v) {
+    return heap->posicao[v] != HEAP_FORA;
+}
+
+static inline void heap_variaveis_subir(HeapVariaveis* heap, int i) {
+    int v = heap->itens[i];
+    double chave = heap->atividade[v];
+
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (heap->atividade[heap->itens[pai]] >= chave) break;
+        heap->itens[i] = heap->itens[pai];
+        heap->posicao[heap->itens[i]] = i;
+        i = pai;
+    }
+    heap->itens[i] = v;
+    heap->posicao[v] = i;
+}
+
+static inline void heap_variaveis_descer(HeapVariaveis* heap, int i) {
+    int v = heap->itens[i];
+    double chave = heap->atividade[v];
+
+    while (2 * i + 1 < heap->tamanho) {
+        int filho = 2 * i + 1;
+        if (filho + 1 < heap->tamanho && heap->atividade[heap->itens[filho + 1]] > heap->atividade[heap->itens[filho]]) {
+            filho++;
+        }
+        if (heap->atividade[heap->itens[filho]] <= chave) break;
+        heap->itens[i] = heap->itens[filho];
+        heap->posicao[heap->itens[i]] = i;
+        i = filho;
+    }
+    heap->itens[i] = v;
+    heap->posicao[v] = i;
+}
+
+// Insere v se ainda não estiver no heap.
+static inline void heap_variaveis_inserir(HeapVariaveis* heap, int v) {
+    if (heap_variaveis_contem(heap, v)) return;
+    heap->itens[heap->tamanho] = v;
+    heap->posicao[v] = heap->tamanho;
+    heap_variaveis_subir(heap, heap->tamanho++);
+}
+
+// Reposiciona v depois que sua atividade aumentou (nada acontece se v estiver fora).
+static inline void heap_variaveis_aumentou(HeapVariaveis* heap, int v) {
+    if (heap_variaveis_contem(heap, v)) heap_variaveis_subir(heap, heap->posicao[v]);
+}
+
+// Remove e retorna a variável de maior atividade. O heap não pode estar vazio.
+static inline int heap_variaveis_remover_maximo(HeapVariaveis* heap) {
+    int maximo = heap->itens[0];
+    heap->posicao[maximo] = HEAP_FORA;
+    if (--heap->tamanho > 0) {
+        heap->itens[0] = heap->itens[heap->tamanho];
+        heap->posicao[heap->itens[0]] = 0;
+        heap_variaveis_descer(heap, 0);
+    }
+    return maximo;
+}
+
+#endif // HEAP_VARIAVEIS_H
@@ -0,0 +1,90 @@
+/*
+    Mede o ganho do modo incremental (sat.h): a mesma sequência de consultas com
+    suposições aleatórias, primeiro em um único resolvedor que guarda o estado e
+    depois com um resolvedor novo para cada consulta.
+
+    Compila com: gcc -O2 incremental_bench.c sat.c -o incremental_bench -pthread
+    Uso: ./incremental_bench arquivo.cnf [consultas] [suposições por consulta]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "sat.h"
+#include "dimacs.h"
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Gerador xorshift: as mesmas suposições nas duas rodadas.
+static uint64_t proximo_aleatorio(uint64_t* estado) {
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void adicionar_formula(SatResolvedor* sat, const Formula* F) {
+    for (int i = 0; i < F->num_clausulas; i++) {
+        sat_adicionar_clausula(sat, F->clausulas[i].literais, F->clausulas[i].num_literais);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Uso: %s arquivo.cnf [consultas] [suposições por consulta]\n", argv[0]);
+        return 1;
+    }
+    int consultas = argc > 2 ? atoi(argv[2]) : 100;
+    int por_consulta = argc > 3 ? atoi(argv[3]) : 3;
+    Formula F = ler_dimacs(argv[1], NULL);
+    if (consultas < 1 || por_consulta < 0 || F.num_variaveis == 0) {
+        printf("Parâmetros inválidos\n");
+        return 1;
+    }
+
+    int* suposicoes = (int*)malloc((size_t)consultas * (por_consulta + 1) * sizeof(int));
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < consultas * por_consulta; i++) {
+        int v = 1 + (int)(proximo_aleatorio(&estado) % (uint64_t)F.num_variaveis);
+        suposicoes[i] = proximo_aleatorio(&estado) & 1 ? v : -v;
+    }
+
+    // Incremental: a primeira consulta (sem suposições) paga a busca inteira.
+    int satisfativeis = 0;
+    double inicio = agora();
+    SatResolvedor* sat = sat_criar();
+    adicionar_formula(sat, &F);
+    sat_resolver(sat, NULL, 0);
+    double primeira = agora() - inicio;
+    inicio = agora();
+    for (int q = 0; q < consultas; q++) {
+        satisfativeis += sat_resolver(sat, suposicoes + q * por_consulta, por_consulta) == SAT_SATISFATIVEL;
+    }
+    double incremental = agora() - inicio;
+    sat_liberar(sat);
+
+    int satisfativeis_do_zero = 0;
+    inicio = agora();
+    for (int q = 0; q < consultas; q++) {
+        sat = sat_criar();
+        adicionar_formula(sat, &F);
+        satisfativeis_do_zero += sat_resolver(sat, suposicoes + q * por_consulta, por_consulta) == SAT_SATISFATIVEL;
+        sat_liberar(sat);
+    }
+    double do_zero = agora() - inicio;
+
+    printf("%s: %d consultas com %d suposições (%d SAT)\n", argv[1], consultas, por_consulta, satisfativeis);
+    printf("  primeira resolução: %.3f ms\n", primeira * 1e3);
+    printf("  incremental:        %.3f ms por consulta\n", incremental * 1e3 / consultas);
+    printf("  do zero:            %.3f ms por consulta\n", do_zero * 1e3 / consultas);
+    if (satisfativeis != satisfativeis_do_zero) printf("  ERRO: as respostas divergem (%d SAT do zero)\n", satisfativeis_do_zero);
+
+    free(suposicoes);
+    liberar_formula(&F);
+    return satisfativeis != satisfativeis_do_zero;
+}
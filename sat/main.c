@@ -3,81 +3,15 @@
 #include <stdbool.h>
 #include <math.h> 
 #include <stdlib.h> 
+#include <time.h>
+#include "formula.h"
+#include "dimacs.h"
+#include "cdcl.h"
+#include "preprocessamento.h"
+#include "portfolio.h"
+#include "drat.h"
+#include "estatisticas.h"
 
-typedef struct {
-    int* literais;    
-    int num_literais;  
-} Clausula;
-
-typedef struct {
-    Clausula* clausulas;
-    int num_clausulas;
-    int num_variaveis;
-} Formula;
-
-typedef struct {
-    int* valores;
-    int num_variaveis;
-} Interpretacao;
-
-Formula ler_dimacs(const char* nome_arquivo) { 
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    if (arquivo == NULL) {
-        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
-        exit(1);
-    }
-
-    Formula F;
-    F.num_clausulas = 0;
-    F.num_variaveis = 0;
-    F.clausulas = NULL; 
-    
-    char linha[1024];
-    
-    while (fgets(linha, sizeof(linha), arquivo)) {
-        if (linha[0] == 'c') { 
-            continue; 
-        }
-        else if (linha[0] == 'p') {
-            sscanf(linha, "p cnf %d %d", &F.num_variaveis, &F.num_clausulas);
-            F.clausulas = (Clausula*)malloc(F.num_clausulas * sizeof(Clausula)); 
-            for (int i = 0; i < F.num_clausulas; i++) { 
-                F.clausulas[i].num_literais = 0; 
-                F.clausulas[i].literais = NULL;
-            }
-            break;
-        }
-    }
-    
-    int clausula_atual = 0;
-    int capacidade_atual = 0; 
-    int literal; 
-    
-    while (fscanf(arquivo, "%d", &literal) != EOF && clausula_atual < F.num_clausulas) { 
-        if (literal == 0) { 
-            clausula_atual++; 
-            continue; 
-        }
-        
-        if (F.clausulas[clausula_atual].num_literais == 0) { 
-            F.clausulas[clausula_atual].literais = (int*)malloc(10 * sizeof(int)); 
-            capacidade_atual = 10;
-        }
-        else if (F.clausulas[clausula_atual].num_literais >= capacidade_atual) { 
-            capacidade_atual *= 2;
-            F.clausulas[clausula_atual].literais = (int*)realloc( 
-                F.clausulas[clausula_atual].literais, 
-                capacidade_atual * sizeof(int)
-            );
-        }
-        
-        F.clausulas[clausula_atual].literais[F.clausulas[clausula_atual].num_literais++] = literal;
-    }
-    
-    fclose(arquivo);
-    return F;
-
-}
 
 bool clausula_satisfeita(const Clausula* clausula, const Interpretacao* interpretacao) {
     for (int i = 0; i < clausula->num_literais; i++) { 
@@ -92,54 +26,135 @@ bool clausula_satisfeita(const Clausula* clausula, const Interpretacao* interpre
     return false;
 }
 
-bool todas_variaveis_atribuidas_na_clausula(const Clausula* clausula, const Interpretacao* interpretacao) {
-    for (int i = 0; i < clausula->num_literais; i++) {
-        int index = abs(clausula->literais[i]);
-        if (interpretacao->valores[index] == -1) {
-            return false;   
+// Resolve a fórmula com o CDCL de cdcl.h (em portfólio se threads > 1), depois do
+// pré-processamento (se pedido). Em caso SAT, preenche interpretacao->valores com
+// um modelo da fórmula original. Com prova != NULL, pré-processamento e busca
+// gravam nela a prova DRAT (só com uma thread). O relatório recebe o tempo das
+// fases e os contadores; se tiver intervalo, a busca imprime o progresso.
+bool resolver_sat(Formula* formula, Interpretacao* interpretacao, bool usar_preprocessamento, int threads,
+                  ProvaDrat* prova, Relatorio* relatorio) {
+    Preprocessador preprocessador;
+    Formula simplificada;
+    Formula* busca = formula;
+
+    if (usar_preprocessamento) {
+        relatorio_comecar_fase(relatorio);
+        bool consistente = preprocessar(&preprocessador, formula, &simplificada, prova);
+        double segundos = relatorio_terminar_fase(relatorio, FASE_PREPROCESSAMENTO);
+        fprintf(stderr, "c pré-processamento: %d -> %d cláusulas; %d fixadas, %d puras, %d eliminadas, "
+                        "%d subsumidas, %d fortalecidas em %.3f s\n",
+                formula->num_clausulas, consistente ? simplificada.num_clausulas : 0, preprocessador.fixadas,
+                preprocessador.puras, preprocessador.eliminadas, preprocessador.subsumidas,
+                preprocessador.fortalecidas, segundos);
+        relatorio->preprocessado = true;
+        relatorio->clausulas_simplificada = consistente ? simplificada.num_clausulas : 0;
+        relatorio->fixadas = preprocessador.fixadas;
+        relatorio->puras = preprocessador.puras;
+        relatorio->eliminadas = preprocessador.eliminadas;
+        relatorio->subsumidas = preprocessador.subsumidas;
+        relatorio->fortalecidas = preprocessador.fortalecidas;
+        if (!consistente) {
+            preprocessador_liberar(&preprocessador);
+            return false;
         }
+        busca = &simplificada;
     }
-    return true;
-}
 
-int encontrar_variavel_livre(const Interpretacao* interpretacao) {
-    for (int i = 1; i <= interpretacao->num_variaveis; i++) {
-        if (interpretacao->valores[i] == -1) {
-            return i;
+    bool satisfativel;
+    relatorio_comecar_fase(relatorio);
+    if (threads > 1) {
+        satisfativel = resolver_portfolio(busca, threads, interpretacao, relatorio);
+    } else {
+        Solver solver;
+        satisfativel = solver_iniciar(&solver, busca, prova);
+        if (satisfativel) {
+            solver.relatorio = relatorio->intervalo > 0 ? relatorio : NULL;
+            satisfativel = solver_buscar(&solver) == RESULTADO_SATISFATIVEL;
         }
+        if (satisfativel) solver_modelo(&solver, interpretacao);
+        solver_somar_contadores(&solver, relatorio);
+        solver_liberar(&solver);
+    }
+    relatorio_terminar_fase(relatorio, FASE_BUSCA);
+    if (satisfativel && usar_preprocessamento) reconstruir_modelo(&preprocessador, interpretacao);
+
+    if (usar_preprocessamento) {
+        liberar_formula(&simplificada);
+        preprocessador_liberar(&preprocessador);
     }
-    return -1;
+    return satisfativel;
 }
 
-bool resolver_sat(Formula* formula, Interpretacao* interpretacao) {
-    for (int i = 0; i < formula->num_clausulas; i++) {
-        if (!clausula_satisfeita(&formula->clausulas[i], interpretacao)) { 
-            if (todas_variaveis_atribuidas_na_clausula(&formula->clausulas[i], interpretacao)) { 
-                return false;
+
+int main(int argc, char* argv[]) {
+    // Uso: ./sat [-P] [-t THREADS] [-p prova.drat] [-s SEGUNDOS] [-j relatorio.json] [arquivo.cnf];
+    // -P desliga o pré-processamento, -t > 1 usa o modo portfólio (-t 0 = um por
+    // núcleo; no máximo PORTFOLIO_MAX_THREADS), -p grava a prova DRAT binária (verificável com verificador_drat),
+    // -s imprime o progresso da busca a cada SEGUNDOS e -j grava as estatísticas
+    // em JSON.
+    bool usar_preprocessamento = true;
+    int threads = 1;
+    const char* arquivo_cnf = "input.txt";
+    const char* arquivo_prova = NULL;
+    const char* arquivo_json = NULL;
+    double intervalo_progresso = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-P") == 0) usar_preprocessamento = false;
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            char* fim;
+            long valor = strtol(argv[++i], &fim, 10);
+            if (fim == argv[i] || *fim != '\0' || valor < 0 || valor > PORTFOLIO_MAX_THREADS) {
+                printf("Erro: número de threads inválido: %s (use 0 a %d)\n", argv[i], PORTFOLIO_MAX_THREADS);
+                return 1;
+            }
+            threads = (int)valor;
+        }
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) arquivo_prova = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            char* fim;
+            intervalo_progresso = strtod(argv[++i], &fim);
+            if (fim == argv[i] || *fim != '\0' || !(intervalo_progresso >= 0)) {
+                printf("Erro: intervalo de progresso inválido: %s\n", argv[i]);
+                return 1;
             }
         }
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) arquivo_json = argv[++i];
+        else arquivo_cnf = argv[i];
     }
+    if (threads <= 0) threads = threads_padrao();
 
-    int var_livre = encontrar_variavel_livre(interpretacao);
-
-    if (var_livre == -1) {
-        return true;
+    ProvaDrat prova;
+    if (arquivo_prova) {
+        if (!drat_abrir(&prova, arquivo_prova)) {
+            printf("Erro: não foi possível criar %s\n", arquivo_prova);
+            return 1;
+        }
+        if (threads > 1) {
+            // Cláusulas importadas de outras threads não teriam justificativa na prova.
+            fprintf(stderr, "c prova DRAT: usando uma thread em vez de %d\n", threads);
+            threads = 1;
+        }
     }
-
-    interpretacao->valores[var_livre] = 1;
-    if (resolver_sat(formula, interpretacao)) return true;
-
-    interpretacao->valores[var_livre] = 0;
-    if (resolver_sat(formula, interpretacao)) return true;
-
-    interpretacao->valores[var_livre] = -1;
-    return false;
-}
-
-
-int main() {
-    const char* arquivo_cnf = "input.txt";
-    Formula F = ler_dimacs(arquivo_cnf); 
+    // Criado antes da busca, como a prova: um caminho inválido não deve custar a execução inteira.
+    FILE* json = NULL;
+    if (arquivo_json && !(json = fopen(arquivo_json, "w"))) {
+        printf("Erro: não foi possível criar %s\n", arquivo_json);
+        return 1;
+    }
+    Relatorio relatorio;
+    relatorio_iniciar(&relatorio, intervalo_progresso);
+    relatorio.arquivo = arquivo_cnf;
+    relatorio.threads = threads;
+
+    size_t bytes = 0;
+    relatorio_comecar_fase(&relatorio);
+    Formula F = ler_dimacs(arquivo_cnf, &bytes);
+    double segundos = relatorio_terminar_fase(&relatorio, FASE_LEITURA);
+    relatorio.variaveis = F.num_variaveis;
+    relatorio.clausulas = F.num_clausulas;
+    // Vai para stderr com o prefixo "c" dos comentários DIMACS, fora da resposta.
+    fprintf(stderr, "c leitura: %.1f MB, %d variáveis, %d cláusulas em %.3f s (%.0f MB/s)\n",
+            bytes / 1e6, F.num_variaveis, F.num_clausulas, segundos, segundos > 0 ? bytes / 1e6 / segundos : 0.0);
     
     Interpretacao I;
     I.num_variaveis = F.num_variaveis;
@@ -147,7 +162,24 @@ int main() {
     for (int i = 0; i <= F.num_variaveis; i++) { 
         I.valores[i] = -1;
     }
-    if (resolver_sat(&F, &I)) {
+    bool satisfativel = resolver_sat(&F, &I, usar_preprocessamento, threads, arquivo_prova ? &prova : NULL,
+                                     &relatorio);
+    relatorio.resultado = satisfativel ? "SAT" : "UNSAT";
+    // A resposta ainda é impressa, mas uma prova incompleta não pode passar por válida.
+    int status = 0;
+    if (arquivo_prova) {
+        bool gravada = drat_fechar(&prova);
+        fprintf(stderr, "c prova: %ld adições, %ld remoções, %.1f MB%s\n", prova.adicionadas, prova.removidas,
+                prova.bytes / 1e6, gravada ? "" : " (ERRO ao gravar)");
+        if (!gravada) status = 1;
+    }
+    if (satisfativel) {
+        for (int i = 0; i < F.num_clausulas; i++) {
+            if (!clausula_satisfeita(&F.clausulas[i], &I)) {
+                printf("Erro: o modelo encontrado não satisfaz a cláusula %d\n", i + 1);
+                return 1;
+            }
+        }
         printf("SAT\n");
         for (int i = 1; i <= F.num_variaveis; i++) {
             printf("%d = %s\n", i, I.valores[i] ? "1" : "0");
@@ -155,13 +187,19 @@ int main() {
     } else {
         printf("UNSAT\n");
     }
-    
-    for (int i = 0; i < F.num_clausulas; i++) {
-        free(F.clausulas[i].literais);
+
+    if (arquivo_json) {
+        relatorio_escrever_json(&relatorio, json);
+        bool gravado = !ferror(json);
+        if (fclose(json) != 0 || !gravado) {
+            fprintf(stderr, "c erro ao gravar %s\n", arquivo_json);
+            status = 1;
+        }
     }
-    free(F.clausulas);
+    
+    liberar_formula(&F);
     free(I.valores);
 
     
-    return 0;
+    return status;
 }
@@ -0,0 +1,110 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "formula.h"
+#include "cdcl.h"
+#include "compartilhamento.h"
+
+/*
+    MODO PORTFÓLIO: N instâncias do CDCL sobre a mesma fórmula, uma por thread.
+
+    A fórmula de entrada é só lida pelas threads; cada instância monta a própria
+    cópia das cláusulas porque os literais observados são reordenados durante a
+    propagação. As instâncias diferem pela política de reinício, pela fase e pela
+    ordem inicial (solver_diversificar), trocam cláusulas aprendidas curtas pelos
+    canais de compartilhamento.h e param quando a primeira termina. A thread 0
+    roda na thread que chamou e é a única que imprime a linha de progresso; os
+    contadores de todas entram no relatório.
+*/
+
+typedef struct {
+    const Formula* formula;
+    Compartilhamento* compartilhamento;
+    int id;
+    int resultado;
+    Relatorio* relatorio;       // só na thread 0, e só com linha de progresso
+    bool iniciada;              // false se a thread não pôde ser criada
+    Solver solver;
+} TarefaPortfolio;
+
+static inline void* executar_tarefa(void* arg) {
+    TarefaPortfolio* tarefa = arg;
+    Solver* s = &tarefa->solver;
+
+    if (!solver_iniciar(s, tarefa->formula, NULL)) {
+        tarefa->resultado = RESULTADO_INSATISFATIVEL;
+    } else {
+        solver_diversificar(s, tarefa->id, tarefa->compartilhamento);
+        s->relatorio = tarefa->relatorio;
+        tarefa->resultado = solver_buscar(s);
+    }
+    if (tarefa->resultado != RESULTADO_INTERROMPIDO) declarar_vencedora(tarefa->compartilhamento, tarefa->id);
+    return NULL;
+}
+
+#define PORTFOLIO_MAX_THREADS 256     // cada thread tem um canal de CANAL_CAPACIDADE cláusulas
+
+// Número de núcleos disponíveis, usado quando o usuário pede 0 threads.
+static inline int threads_padrao() {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > PORTFOLIO_MAX_THREADS) n = PORTFOLIO_MAX_THREADS;
+    return n > 0 ? (int)n : 1;
+}
+
+// Resolve com num_threads instâncias. Em caso SAT, copia o modelo da vencedora
+// para modelo->valores (variáveis 1 a modelo->num_variaveis). Os contadores de
+// todas as threads são somados ao relatório. Threads que não puderem ser criadas
+// ficam de fora; a 0 roda na thread de quem chamou e sempre participa.
+static inline bool resolver_portfolio(const Formula* formula, int num_threads, Interpretacao* modelo, Relatorio* relatorio) {
+    Compartilhamento compartilhamento;
+    compartilhamento_iniciar(&compartilhamento, num_threads);
+
+    pthread_t ids[num_threads];
+    TarefaPortfolio* tarefas = (TarefaPortfolio*)calloc(num_threads, sizeof(TarefaPortfolio));
+    int iniciadas = 1;
+    for (int t = 0; t < num_threads; t++) {
+        tarefas[t] = (TarefaPortfolio){.formula = formula, .compartilhamento = &compartilhamento, .id = t,
+                                       .resultado = RESULTADO_INTERROMPIDO,
+                                       .relatorio = t == 0 && relatorio->intervalo > 0 ? relatorio : NULL,
+                                       .iniciada = t == 0};
+        if (t > 0 && pthread_create(&ids[t], NULL, executar_tarefa, &tarefas[t]) == 0) {
+            tarefas[t].iniciada = true;
+            iniciadas++;
+        }
+    }
+    if (iniciadas < num_threads) {
+        fprintf(stderr, "c portfólio: só %d de %d threads puderam ser criadas\n", iniciadas, num_threads);
+    }
+    executar_tarefa(&tarefas[0]);
+    for (int t = 1; t < num_threads; t++) {
+        if (tarefas[t].iniciada) pthread_join(ids[t], NULL);
+    }
+
+    const TarefaPortfolio* vencedora = &tarefas[atomic_load(&compartilhamento.vencedora)];
+    bool satisfativel = vencedora->resultado == RESULTADO_SATISFATIVEL;
+    if (satisfativel) solver_modelo(&vencedora->solver, modelo);
+
+    long conflitos = 0, importadas = 0;
+    for (int t = 0; t < num_threads; t++) {
+        if (!tarefas[t].iniciada) continue;
+        conflitos += tarefas[t].solver.conflitos;
+        importadas += tarefas[t].solver.importadas;
+        solver_somar_contadores(&tarefas[t].solver, relatorio);
+    }
+    fprintf(stderr, "c portfólio: %d threads, thread %d terminou; %ld conflitos e %ld cláusulas importadas no total\n",
+            iniciadas, vencedora->id, conflitos, importadas);
+
+    for (int t = 0; t < num_threads; t++) {
+        if (tarefas[t].iniciada) solver_liberar(&tarefas[t].solver);
+    }
+    free(tarefas);
+    compartilhamento_liberar(&compartilhamento);
+    return satisfativel;
+}
+
+#endif // PORTFOLIO_H
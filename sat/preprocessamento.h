@@ -0,0 +1,530 @@
+#ifndef PREPROCESSAMENTO_H
+#define PREPROCESSAMENTO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "formula.h"
+#include "cdcl.h"
+
+/*
+    PRÉ-PROCESSAMENTO DA FÓRMULA (antes da busca)
+
+    Repete, até nada mudar ou por PREPROCESSAMENTO_RODADAS rodadas:
+        - literais unitários: o literal é fixado, as cláusulas que o contêm somem
+          e o literal oposto sai das demais;
+        - literais puros: uma variável que só aparece com um sinal recebe esse
+          sinal e suas cláusulas somem;
+        - subsunção: se C está contida em D, D sai;
+        - auto-subsunção: se C = (l ou R) e D = (-l ou S) com R contido em S,
+          -l sai de D;
+        - eliminação de variáveis (BVE): as cláusulas com x e com -x são trocadas
+          por todas as resolventes não tautológicas entre elas, desde que isso não
+          aumente o número de cláusulas (e as resolventes não sejam grandes demais).
+    Literais repetidos e tautologias já saem ao carregar a fórmula.
+
+    Reconstrução do modelo: cada passo que tira uma variável da fórmula empilha
+    cláusulas com o literal "pivô" na frente (o literal fixado ou puro sozinho;
+    na eliminação, as cláusulas removidas, com x ou -x como pivô). Depois da busca,
+    a pilha é percorrida do topo para a base e, para cada cláusula ainda falsa no
+    modelo, o pivô passa a ser verdadeiro. O resultado satisfaz a fórmula original.
+
+    As cláusulas não precisam estar ordenadas: os testes de inclusão marcam os
+    literais em marca (indexada por num_variaveis + literal). As listas de
+    ocorrência podem conter cláusulas já removidas, descartadas ao percorrê-las.
+    Cada cláusula tem uma assinatura de 64 bits (bit v % 64 de cada variável v):
+    se alguma variável de C falta na assinatura de D, C não está contida em D e
+    D nem precisa ser lida. Depois da primeira rodada, a subsunção só parte das
+    cláusulas novas ou encurtadas e a eliminação só tenta as variáveis cujas
+    ocorrências mudaram.
+
+    Com uma prova DRAT (veja drat.h), cada cláusula nova ou encurtada é gravada
+    como adição antes de ser usada (resolventes, cláusulas fortalecidas e
+    cláusulas que perdem literais fixados) e cada cláusula removida como
+    remoção. A versão anterior de uma cláusula fortalecida também sai da prova.
+    As unitárias nunca são removidas: o verificador precisa delas para as
+    próximas cláusulas. Fixar literais puros não entra na prova, porque só tira
+    cláusulas.
+*/
+
+#define PREPROCESSAMENTO_RODADAS 8
+#define ELIMINACAO_MAX_OCORRENCIAS 16   // acima de pos + neg, a variável não é eliminada
+#define ELIMINACAO_MAX_RESOLVENTE 20    // uma resolvente maior impede a eliminação
+#define SUBSUNCAO_MAX_OCORRENCIAS 1000  // listas maiores não são usadas para auto-subsunção
+
+typedef struct {
+    int num_variaveis;
+    Clausula* clausulas;        // cada uma com seu próprio vetor (NULL depois de removida)
+    char* removida;
+    char* tocada;               // cláusula nova ou encurtada desde a última subsunção
+    uint64_t* assinatura;       // variáveis de cada cláusula, módulo 64
+    int num_clausulas;
+    int capacidade_clausulas;
+    int clausulas_vivas;
+
+    ListaInt* ocorrencias;      // cláusulas de cada literal (pode conter removidas)
+    int* contagem;              // cláusulas vivas de cada literal
+    int* valores;               // -1 livre, 0 falso, 1 verdadeiro (fixadas)
+    char* eliminada;            // variável tirada da fórmula por ser pura ou por BVE
+    char* variavel_tocada;      // ocorrências mudaram desde a última tentativa de eliminação
+    char* marca;                // literais marcados nos testes de inclusão
+    ListaInt fila;              // literais unitários ainda não aplicados
+    int inicio_fila;
+    ListaInt pilha;             // reconstrução: [pivô, demais literais..., tamanho] em sequência
+    ListaInt resolventes;       // [tamanho, literais...] durante uma eliminação
+    bool insatisfativel;
+    long mudancas;
+    ProvaDrat* prova;           // NULL sem prova DRAT
+
+    int fixadas, puras, eliminadas, subsumidas, fortalecidas;
+} Preprocessador;
+
+static inline ListaInt* prep_ocorrencias(Preprocessador* P, int literal) {
+    return &P->ocorrencias[P->num_variaveis + literal];
+}
+
+static inline int* prep_contagem(Preprocessador* P, int literal) {
+    return &P->contagem[P->num_variaveis + literal];
+}
+
+static inline char* prep_marca(Preprocessador* P, int literal) {
+    return &P->marca[P->num_variaveis + literal];
+}
+
+static inline uint64_t calcular_assinatura(const Clausula* c) {
+    uint64_t assinatura = 0;
+    for (int i = 0; i < c->num_literais; i++) assinatura |= 1ull << (abs(c->literais[i]) & 63);
+    return assinatura;
+}
+
+static inline int prep_valor(const Preprocessador* P, int literal) {
+    int valor = P->valores[abs(literal)];
+    if (valor < 0) return -1;
+    return literal > 0 ? valor : 1 - valor;
+}
+
+// Tira da lista as cláusulas removidas.
+static inline void limpar_ocorrencias(Preprocessador* P, ListaInt* lista) {
+    int mantidas = 0;
+    for (int k = 0; k < lista->tamanho; k++) {
+        if (!P->removida[lista->itens[k]]) lista->itens[mantidas++] = lista->itens[k];
+    }
+    lista->tamanho = mantidas;
+}
+
+static inline void empilhar_reconstrucao(Preprocessador* P, const int* literais, int num_literais, int pivo) {
+    lista_adicionar(&P->pilha, pivo);
+    for (int i = 0; i < num_literais; i++) {
+        if (literais[i] != pivo) lista_adicionar(&P->pilha, literais[i]);
+    }
+    lista_adicionar(&P->pilha, num_literais);
+}
+
+static inline void remover_clausula(Preprocessador* P, int indice) {
+    if (P->removida[indice]) return;
+
+    Clausula* c = &P->clausulas[indice];
+    if (P->prova && c->num_literais > 1) drat_clausula_dimacs(P->prova, 'd', c->literais, c->num_literais);
+    for (int i = 0; i < c->num_literais; i++) {
+        (*prep_contagem(P, c->literais[i]))--;
+        P->variavel_tocada[abs(c->literais[i])] = 1;
+    }
+    free(c->literais);
+    c->literais = NULL;
+    c->num_literais = 0;
+    P->removida[indice] = 1;
+    P->clausulas_vivas--;
+    P->mudancas++;
+}
+
+// Acrescenta uma cláusula sem literais repetidos nem tautologia. Literais já
+// fixados são levados em conta; unitárias vão para a fila.
+static inline void adicionar_clausula_prep(Preprocessador* P, const int* literais, int num_literais) {
+    if (P->num_clausulas == P->capacidade_clausulas) {
+        P->capacidade_clausulas = P->capacidade_clausulas ? 2 * P->capacidade_clausulas : 16;
+        P->clausulas = (Clausula*)realloc(P->clausulas, P->capacidade_clausulas * sizeof(Clausula));
+        P->removida = (char*)realloc(P->removida, P->capacidade_clausulas);
+        P->tocada = (char*)realloc(P->tocada, P->capacidade_clausulas);
+        P->assinatura = (uint64_t*)realloc(P->assinatura, P->capacidade_clausulas * sizeof(uint64_t));
+    }
+
+    Clausula* c = &P->clausulas[P->num_clausulas];
+    c->literais = (int*)malloc((num_literais > 0 ? num_literais : 1) * sizeof(int));
+    c->num_literais = 0;
+    for (int i = 0; i < num_literais; i++) {
+        int valor = prep_valor(P, literais[i]);
+        if (valor == 1) {
+            free(c->literais);
+            return;
+        }
+        if (valor == -1) c->literais[c->num_literais++] = literais[i];
+    }
+    if (P->prova && c->num_literais < num_literais) drat_clausula_dimacs(P->prova, 'a', c->literais, c->num_literais);
+
+    if (c->num_literais <= 1) {
+        if (c->num_literais == 0) P->insatisfativel = true;
+        else lista_adicionar(&P->fila, c->literais[0]);
+        free(c->literais);
+        return;
+    }
+
+    for (int i = 0; i < c->num_literais; i++) {
+        lista_adicionar(prep_ocorrencias(P, c->literais[i]), P->num_clausulas);
+        (*prep_contagem(P, c->literais[i]))++;
+        P->variavel_tocada[abs(c->literais[i])] = 1;
+    }
+    P->removida[P->num_clausulas] = 0;
+    P->assinatura[P->num_clausulas] = calcular_assinatura(c);
+    P->tocada[P->num_clausulas++] = 1;
+    P->clausulas_vivas++;
+}
+
+// Tira "literal" da cláusula (quem chama cuida da lista de ocorrência dele). Se
+// sobrar um literal, ele vai para a fila e a cláusula sai.
+static inline void fortalecer_clausula(Preprocessador* P, int indice, int literal) {
+    Clausula* c = &P->clausulas[indice];
+    int i = 0;
+    while (c->literais[i] != literal) i++;
+    c->literais[i] = c->literais[--c->num_literais];
+    if (P->prova) {
+        // A versão antiga é a nova com "literal" de volta no fim do vetor.
+        c->literais[c->num_literais] = literal;
+        drat_clausula_dimacs(P->prova, 'a', c->literais, c->num_literais);
+        drat_clausula_dimacs(P->prova, 'd', c->literais, c->num_literais + 1);
+    }
+    (*prep_contagem(P, literal))--;
+    P->variavel_tocada[abs(literal)] = 1;
+    P->tocada[indice] = 1;
+    P->assinatura[indice] = calcular_assinatura(c);
+    P->mudancas++;
+
+    if (c->num_literais == 1) {
+        lista_adicionar(&P->fila, c->literais[0]);
+        remover_clausula(P, indice);
+    }
+}
+
+// Aplica os literais unitários da fila.
+static inline void propagar_unitarias(Preprocessador* P) {
+    while (P->inicio_fila < P->fila.tamanho && !P->insatisfativel) {
+        int literal = P->fila.itens[P->inicio_fila++];
+        int valor = prep_valor(P, literal);
+        if (valor == 1) continue;
+        if (valor == 0) {
+            P->insatisfativel = true;
+            return;
+        }
+
+        P->valores[abs(literal)] = literal > 0 ? 1 : 0;
+        P->fixadas++;
+        empilhar_reconstrucao(P, &literal, 1, literal);
+
+        ListaInt* satisfeitas = prep_ocorrencias(P, literal);
+        for (int k = 0; k < satisfeitas->tamanho; k++) remover_clausula(P, satisfeitas->itens[k]);
+        satisfeitas->tamanho = 0;
+
+        ListaInt* encurtadas = prep_ocorrencias(P, -literal);
+        for (int k = 0; k < encurtadas->tamanho; k++) {
+            if (!P->removida[encurtadas->itens[k]]) fortalecer_clausula(P, encurtadas->itens[k], -literal);
+        }
+        encurtadas->tamanho = 0;
+    }
+    P->fila.tamanho = P->inicio_fila = 0;
+}
+
+static inline void eliminar_puros(Preprocessador* P) {
+    for (int v = 1; v <= P->num_variaveis && !P->insatisfativel; v++) {
+        if (P->valores[v] != -1 || P->eliminada[v]) continue;
+
+        int positivos = *prep_contagem(P, v), negativos = *prep_contagem(P, -v);
+        if ((positivos == 0) == (negativos == 0)) continue;
+
+        int puro = positivos > 0 ? v : -v;
+        ListaInt* lista = prep_ocorrencias(P, puro);
+        empilhar_reconstrucao(P, &puro, 1, puro);
+        for (int k = 0; k < lista->tamanho; k++) remover_clausula(P, lista->itens[k]);
+        lista->tamanho = 0;
+        P->eliminada[v] = 1;
+        P->puras++;
+    }
+}
+
+// Quantos literais de D estão marcados (C está contida em D se forem todos os de C).
+static inline int literais_marcados(Preprocessador* P, const Clausula* d) {
+    int marcados = 0;
+    for (int i = 0; i < d->num_literais; i++) marcados += *prep_marca(P, d->literais[i]);
+    return marcados;
+}
+
+// Subsunção e auto-subsunção com cada cláusula tocada no papel de C.
+static inline void subsumir(Preprocessador* P) {
+    for (int indice = 0; indice < P->num_clausulas && !P->insatisfativel; indice++) {
+        if (P->removida[indice] || !P->tocada[indice]) continue;
+        P->tocada[indice] = 0;
+        const Clausula* c = &P->clausulas[indice];
+        int n = c->num_literais;
+        uint64_t assinatura = P->assinatura[indice];
+
+        // Toda cláusula que contém C está na menor lista de ocorrência dos literais de C.
+        int menor = c->literais[0];
+        for (int i = 1; i < n; i++) {
+            if (prep_ocorrencias(P, c->literais[i])->tamanho < prep_ocorrencias(P, menor)->tamanho) {
+                menor = c->literais[i];
+            }
+        }
+
+        for (int i = 0; i < n; i++) *prep_marca(P, c->literais[i]) = 1;
+
+        ListaInt* lista = prep_ocorrencias(P, menor);
+        limpar_ocorrencias(P, lista);
+        for (int k = 0; k < lista->tamanho; k++) {
+            int outra = lista->itens[k];
+            if (outra == indice || (assinatura & ~P->assinatura[outra]) != 0) continue;
+            const Clausula* d = &P->clausulas[outra];
+            if (d->num_literais >= n && literais_marcados(P, d) == n) {
+                remover_clausula(P, outra);
+                P->subsumidas++;
+            }
+        }
+
+        // Auto-subsunção: com l trocado por -l, C contida em D permite tirar -l de D.
+        for (int i = 0; i < n; i++) {
+            int l = c->literais[i];
+            ListaInt* opostas = prep_ocorrencias(P, -l);
+            if (opostas->tamanho > SUBSUNCAO_MAX_OCORRENCIAS) continue;
+
+            *prep_marca(P, l) = 0;
+            *prep_marca(P, -l) = 1;
+            limpar_ocorrencias(P, opostas);
+            for (int k = 0; k < opostas->tamanho; k++) {
+                int outra = opostas->itens[k];
+                if ((assinatura & ~P->assinatura[outra]) != 0) continue;
+                const Clausula* d = &P->clausulas[outra];
+                if (d->num_literais >= n && literais_marcados(P, d) == n) {
+                    opostas->itens[k--] = opostas->itens[--opostas->tamanho];
+                    fortalecer_clausula(P, outra, -l);
+                    P->fortalecidas++;
+                }
+            }
+            *prep_marca(P, -l) = 0;
+            *prep_marca(P, l) = 1;
+        }
+
+        for (int i = 0; i < n; i++) *prep_marca(P, c->literais[i]) = 0;
+        propagar_unitarias(P);
+    }
+}
+
+// Tenta eliminar x por resolução. Retorna true se eliminou.
+static inline bool eliminar_variavel(Preprocessador* P, int x) {
+    ListaInt* positivas = prep_ocorrencias(P, x);
+    ListaInt* negativas = prep_ocorrencias(P, -x);
+    limpar_ocorrencias(P, positivas);
+    limpar_ocorrencias(P, negativas);
+
+    int limite = positivas->tamanho + negativas->tamanho;
+    if (positivas->tamanho == 0 || negativas->tamanho == 0 || limite > ELIMINACAO_MAX_OCORRENCIAS) return false;
+
+    // Gera as resolventes; desiste se forem mais numerosas que as cláusulas removidas.
+    int quantas = 0;
+    P->resolventes.tamanho = 0;
+    for (int a = 0; a < positivas->tamanho; a++) {
+        const Clausula* ca = &P->clausulas[positivas->itens[a]];
+        for (int i = 0; i < ca->num_literais; i++) *prep_marca(P, ca->literais[i]) = 1;
+
+        for (int b = 0; b < negativas->tamanho; b++) {
+            const Clausula* cb = &P->clausulas[negativas->itens[b]];
+            int inicio = P->resolventes.tamanho;
+            bool tautologia = false;
+
+            lista_adicionar(&P->resolventes, 0);
+            for (int i = 0; i < ca->num_literais; i++) {
+                if (ca->literais[i] != x) lista_adicionar(&P->resolventes, ca->literais[i]);
+            }
+            for (int i = 0; i < cb->num_literais && !tautologia; i++) {
+                int q = cb->literais[i];
+                if (q == -x || *prep_marca(P, q)) continue;
+                if (*prep_marca(P, -q)) tautologia = true;
+                else lista_adicionar(&P->resolventes, q);
+            }
+
+            int tamanho = P->resolventes.tamanho - inicio - 1;
+            if (tautologia) {
+                P->resolventes.tamanho = inicio;
+                continue;
+            }
+            P->resolventes.itens[inicio] = tamanho;
+            if (tamanho > ELIMINACAO_MAX_RESOLVENTE || ++quantas > limite) {
+                for (int i = 0; i < ca->num_literais; i++) *prep_marca(P, ca->literais[i]) = 0;
+                return false;
+            }
+        }
+        for (int i = 0; i < ca->num_literais; i++) *prep_marca(P, ca->literais[i]) = 0;
+    }
+
+    // Na prova, as resolventes entram enquanto as cláusulas de x ainda existem.
+    for (int k = 0; P->prova && k < P->resolventes.tamanho; k += P->resolventes.itens[k] + 1) {
+        drat_clausula_dimacs(P->prova, 'a', &P->resolventes.itens[k + 1], P->resolventes.itens[k]);
+    }
+    for (int k = 0; k < positivas->tamanho; k++) {
+        const Clausula* c = &P->clausulas[positivas->itens[k]];
+        empilhar_reconstrucao(P, c->literais, c->num_literais, x);
+        remover_clausula(P, positivas->itens[k]);
+    }
+    for (int k = 0; k < negativas->tamanho; k++) {
+        const Clausula* c = &P->clausulas[negativas->itens[k]];
+        empilhar_reconstrucao(P, c->literais, c->num_literais, -x);
+        remover_clausula(P, negativas->itens[k]);
+    }
+    positivas->tamanho = negativas->tamanho = 0;
+    P->eliminada[x] = 1;
+    P->eliminadas++;
+
+    for (int k = 0; k < P->resolventes.tamanho; k += P->resolventes.itens[k] + 1) {
+        adicionar_clausula_prep(P, &P->resolventes.itens[k + 1], P->resolventes.itens[k]);
+    }
+    propagar_unitarias(P);
+    return true;
+}
+
+static const Preprocessador* prep_ordenacao;
+
+// Candidatas com menos pares de resolução primeiro.
+static inline int comparar_candidatas(const void* a, const void* b) {
+    const Preprocessador* P = prep_ordenacao;
+    int x = *(const int*)a, y = *(const int*)b;
+    long custo_x = (long)P->contagem[P->num_variaveis + x] * P->contagem[P->num_variaveis - x];
+    long custo_y = (long)P->contagem[P->num_variaveis + y] * P->contagem[P->num_variaveis - y];
+    return (custo_x > custo_y) - (custo_x < custo_y);
+}
+
+static inline void eliminar_variaveis(Preprocessador* P) {
+    int* candidatas = (int*)malloc((P->num_variaveis + 1) * sizeof(int));
+    int num_candidatas = 0;
+    for (int v = 1; v <= P->num_variaveis; v++) {
+        int total = *prep_contagem(P, v) + *prep_contagem(P, -v);
+        if (P->variavel_tocada[v] && P->valores[v] == -1 && !P->eliminada[v] &&
+            total > 0 && total <= ELIMINACAO_MAX_OCORRENCIAS) {
+            candidatas[num_candidatas++] = v;
+        }
+        P->variavel_tocada[v] = 0;
+    }
+    prep_ordenacao = P;
+    qsort(candidatas, num_candidatas, sizeof(int), comparar_candidatas);
+
+    for (int i = 0; i < num_candidatas && !P->insatisfativel; i++) {
+        int v = candidatas[i];
+        if (P->valores[v] == -1 && !P->eliminada[v]) eliminar_variavel(P, v);
+    }
+    free(candidatas);
+}
+
+static inline void preprocessador_liberar(Preprocessador* P) {
+    for (int i = 0; i < P->num_clausulas; i++) free(P->clausulas[i].literais);
+    for (int i = 0; i <= 2 * P->num_variaveis; i++) free(P->ocorrencias[i].itens);
+    free(P->clausulas);
+    free(P->removida);
+    free(P->tocada);
+    free(P->assinatura);
+    free(P->variavel_tocada);
+    free(P->ocorrencias);
+    free(P->contagem);
+    free(P->valores);
+    free(P->eliminada);
+    free(P->marca);
+    free(P->fila.itens);
+    free(P->pilha.itens);
+    free(P->resolventes.itens);
+}
+
+// Simplifica a fórmula. Retorna false se ela for insatisfatível; senão, *saida
+// recebe a fórmula simplificada (mesmas variáveis, liberar com liberar_formula).
+// A prova pode ser NULL.
+static inline bool preprocessar(Preprocessador* P, const Formula* entrada, Formula* saida, ProvaDrat* prova) {
+    memset(P, 0, sizeof(*P));
+    P->prova = prova;
+
+    int n = entrada->num_variaveis;
+    for (int i = 0; i < entrada->num_clausulas; i++) {
+        for (int j = 0; j < entrada->clausulas[i].num_literais; j++) {
+            if (abs(entrada->clausulas[i].literais[j]) > n) n = abs(entrada->clausulas[i].literais[j]);
+        }
+    }
+    P->num_variaveis = n;
+    P->ocorrencias = (ListaInt*)calloc(2 * n + 1, sizeof(ListaInt));
+    P->contagem = (int*)calloc(2 * n + 1, sizeof(int));
+    P->marca = (char*)calloc(2 * n + 1, 1);
+    P->eliminada = (char*)calloc(n + 1, 1);
+    P->variavel_tocada = (char*)calloc(n + 1, 1);
+    P->valores = (int*)malloc((n + 1) * sizeof(int));
+    for (int v = 0; v <= n; v++) P->valores[v] = -1;
+
+    // Carrega sem repetidos e sem tautologias (resolventes servem de espaço temporário).
+    for (int i = 0; i < entrada->num_clausulas && !P->insatisfativel; i++) {
+        const Clausula* original = &entrada->clausulas[i];
+        bool tautologia = false;
+        P->resolventes.tamanho = 0;
+        for (int j = 0; j < original->num_literais; j++) {
+            int q = original->literais[j];
+            if (*prep_marca(P, q)) continue;
+            if (*prep_marca(P, -q)) tautologia = true;
+            *prep_marca(P, q) = 1;
+            lista_adicionar(&P->resolventes, q);
+        }
+        for (int j = 0; j < P->resolventes.tamanho; j++) *prep_marca(P, P->resolventes.itens[j]) = 0;
+        if (!tautologia) adicionar_clausula_prep(P, P->resolventes.itens, P->resolventes.tamanho);
+    }
+
+    for (int rodada = 0; rodada < PREPROCESSAMENTO_RODADAS && !P->insatisfativel; rodada++) {
+        long antes = P->mudancas;
+        propagar_unitarias(P);
+        eliminar_puros(P);
+        subsumir(P);
+        eliminar_variaveis(P);
+        if (P->mudancas == antes) break;
+    }
+    if (P->insatisfativel) {
+        if (P->prova) drat_clausula_dimacs(P->prova, 'a', NULL, 0);
+        return false;
+    }
+
+    long total_literais = 0;
+    for (int i = 0; i < P->num_clausulas; i++) total_literais += P->clausulas[i].num_literais;
+
+    saida->num_variaveis = n;
+    saida->num_clausulas = 0;
+    saida->literais = (int*)malloc((total_literais + 1) * sizeof(int));
+    saida->clausulas = (Clausula*)malloc((P->clausulas_vivas + 1) * sizeof(Clausula));
+    long usados = 0;
+    for (int i = 0; i < P->num_clausulas; i++) {
+        if (P->removida[i]) continue;
+        Clausula* c = &saida->clausulas[saida->num_clausulas++];
+        c->literais = saida->literais + usados;
+        c->num_literais = P->clausulas[i].num_literais;
+        memcpy(c->literais, P->clausulas[i].literais, c->num_literais * sizeof(int));
+        usados += c->num_literais;
+    }
+    return true;
+}
+
+// Completa um modelo da fórmula simplificada (valores 0/1 para todas as
+// variáveis) para que satisfaça a fórmula original.
+static inline void reconstruir_modelo(const Preprocessador* P, Interpretacao* modelo) {
+    int i = P->pilha.tamanho;
+    while (i > 0) {
+        int tamanho = P->pilha.itens[--i];
+        i -= tamanho;
+        const int* literais = &P->pilha.itens[i];
+
+        bool satisfeita = false;
+        for (int j = 0; j < tamanho && !satisfeita; j++) {
+            int valor = modelo->valores[abs(literais[j])];
+            satisfeita = literais[j] > 0 ? valor == 1 : valor == 0;
+        }
+        if (!satisfeita) modelo->valores[abs(literais[0])] = literais[0] > 0 ? 1 : 0;
+    }
+}
+
+#endif // PREPROCESSAMENTO_H
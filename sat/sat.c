@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "sat.h"
+#include "cdcl.h"
+
+struct SatResolvedor {
+    Solver solver;
+    int resultado;      // última resposta de sat_resolver, ou 0 se não houver
+};
+
+SatResolvedor* sat_criar(void) {
+    SatResolvedor* sat = (SatResolvedor*)malloc(sizeof(SatResolvedor));
+    if (sat == NULL) return NULL;
+
+    Formula vazia = {NULL, NULL, 0, 0};
+    solver_iniciar(&sat->solver, &vazia, NULL);
+    sat->resultado = 0;
+    return sat;
+}
+
+void sat_liberar(SatResolvedor* sat) {
+    if (sat == NULL) return;
+    solver_liberar(&sat->solver);
+    free(sat);
+}
+
+int sat_adicionar_clausula(SatResolvedor* sat, const int* literais, int num_literais) {
+    for (int i = 0; i < num_literais; i++) {
+        if (literais[i] == 0) {
+            fprintf(stderr, "sat_adicionar_clausula: literal 0 na posição %d\n", i);
+            return -1;
+        }
+    }
+    // A busca anterior deixa a trilha montada para sat_valor; a cláusula entra no nível 0.
+    retroceder(&sat->solver, 0);
+    sat->resultado = 0;
+    solver_adicionar_clausula(&sat->solver, literais, num_literais);
+    return 0;
+}
+
+int sat_resolver(SatResolvedor* sat, const int* suposicoes, int num_suposicoes) {
+    int maior = 0;
+    for (int i = 0; i < num_suposicoes; i++) {
+        if (suposicoes[i] == 0) {
+            fprintf(stderr, "sat_resolver: suposição 0 na posição %d\n", i);
+            return -1;
+        }
+        if (abs(suposicoes[i]) > maior) maior = abs(suposicoes[i]);
+    }
+    retroceder(&sat->solver, 0);
+    solver_ampliar(&sat->solver, maior);
+
+    sat->solver.suposicoes = suposicoes;
+    sat->solver.num_suposicoes = num_suposicoes;
+    int resultado = solver_buscar(&sat->solver);
+    sat->solver.suposicoes = NULL;
+    sat->solver.num_suposicoes = 0;
+
+    sat->resultado = resultado == RESULTADO_SATISFATIVEL ? SAT_SATISFATIVEL : SAT_INSATISFATIVEL;
+    return sat->resultado;
+}
+
+int sat_valor(const SatResolvedor* sat, int literal) {
+    int v = abs(literal);
+    if (sat->resultado != SAT_SATISFATIVEL || v == 0 || v > sat->solver.num_variaveis) return -1;
+    return sat->solver.valor[codificar_literal(literal)];
+}
+
+int sat_nucleo(const SatResolvedor* sat, const int** nucleo) {
+    if (sat->resultado != SAT_INSATISFATIVEL) {
+        *nucleo = NULL;
+        return 0;
+    }
+    *nucleo = sat->solver.nucleo.itens;
+    return sat->solver.nucleo.tamanho;
+}
+
+int sat_num_variaveis(const SatResolvedor* sat) {
+    return sat->solver.num_variaveis;
+}
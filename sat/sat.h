@@ -0,0 +1,48 @@
+#ifndef SAT_H
+#define SAT_H
+
+/*
+    API pública do resolvedor SAT em modo incremental (biblioteca libsat).
+
+    Um SatResolvedor guarda o estado entre as chamadas: cláusulas originais e
+    aprendidas, atividades das variáveis e fases salvas. Por isso, depois da
+    primeira resolução, consultas parecidas (com outras suposições ou algumas
+    cláusulas a mais) costumam custar milissegundos.
+
+    Literais seguem o DIMACS: v é a variável v verdadeira e -v, falsa. As
+    variáveis são criadas quando aparecem pela primeira vez em uma cláusula ou
+    suposição. Não há pré-processamento neste modo: ele eliminaria variáveis que
+    cláusulas ou suposições futuras ainda podem usar.
+*/
+
+enum {
+    SAT_SATISFATIVEL = 10,      // os mesmos códigos de saída das competições de SAT
+    SAT_INSATISFATIVEL = 20
+};
+
+typedef struct SatResolvedor SatResolvedor;
+
+SatResolvedor* sat_criar(void);
+void sat_liberar(SatResolvedor* sat);
+
+// Acrescenta uma cláusula (a última resposta e o seu modelo deixam de valer).
+// Retorna 0, ou -1 se algum literal for 0.
+int sat_adicionar_clausula(SatResolvedor* sat, const int* literais, int num_literais);
+
+// Resolve a fórmula supondo verdadeiros os literais de suposicoes (que valem só
+// nesta chamada). Retorna SAT_SATISFATIVEL, SAT_INSATISFATIVEL ou -1 em erro.
+int sat_resolver(SatResolvedor* sat, const int* suposicoes, int num_suposicoes);
+
+// Depois de SAT_SATISFATIVEL: 1 se o literal é verdadeiro no modelo, 0 se é
+// falso. Retorna -1 sem modelo ou para uma variável que não existe.
+int sat_valor(const SatResolvedor* sat, int literal);
+
+// Depois de SAT_INSATISFATIVEL: as suposições que bastam para a resposta (um
+// subconjunto das passadas a sat_resolver). Vazio se a fórmula for
+// insatisfatível sem suposição alguma. Retorna quantas são; *nucleo vale até a
+// próxima chamada que altere o resolvedor.
+int sat_nucleo(const SatResolvedor* sat, const int** nucleo);
+
+int sat_num_variaveis(const SatResolvedor* sat);
+
+#endif // SAT_H
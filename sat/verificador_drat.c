@@ -0,0 +1,662 @@
+/*
+    Verificador de provas DRAT: confere que a prova gravada por "./sat -p" (ou
+    qualquer prova DRAT, binária ou em texto) refuta a fórmula.
+
+    Compila com: gcc -O2 verificador_drat.c -o verificador_drat
+    Uso: ./verificador_drat [-f] formula.cnf prova.drat
+    Imprime "s VERIFICADA" (código de saída 0) ou "s NÃO VERIFICADA" (código 1).
+
+    A prova é uma sequência de adições (lemas) e remoções de cláusulas. Cada lema
+    precisa ser RUP: negando seus literais, a propagação unitária sobre as
+    cláusulas vivas chega a um conflito. Se não for, vale RAT no primeiro literal
+    l: toda resolvente do lema com uma cláusula viva que contém -l é RUP. A prova
+    está completa quando as cláusulas vivas entram em conflito sem decisão
+    nenhuma (a cláusula vazia).
+
+    Modo para trás (padrão): o primeiro passe só aplica a prova, mantendo as
+    atribuições do nível 0 e guardando o tamanho da trilha antes de cada passo,
+    até o conflito final. Depois a prova é desfeita do fim para o começo, e só
+    os lemas marcados (usados no conflito final ou na verificação de outro lema
+    marcado) são verificados; cada verificação marca as cláusulas de que
+    precisou. Os lemas que nunca contribuem para a refutação nem são conferidos.
+    Modo para frente (-f): cada lema é verificado quando entra.
+
+    Como no drat-trim, remover uma cláusula que é razão de uma atribuição do
+    nível 0 é ignorado (com um aviso na contagem): a atribuição continuaria
+    valendo sem justificativa. Remoções de cláusulas que não existem também são
+    ignoradas. Manter cláusulas a mais nunca aceita uma prova errada.
+
+    As cláusulas ficam num único vetor de literais codificados como em cdcl.h
+    (2v e 2v + 1), sem repetidos. Remoções são casadas com uma tabela de
+    espalhamento das cláusulas vivas, com uma soma de espalhamentos por literal
+    (não depende da ordem dos literais).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "dimacs.h"
+
+#define RAZAO_SUPOSICAO -1          // literal atribuído pela negação do lema em verificação
+
+typedef struct {
+    long inicio;                // posição em Verificador.literais
+    int tamanho;
+    int pivo;                   // primeiro literal como veio na prova (RAT)
+    unsigned espalhamento;
+    char ativa;
+    char marcada;               // usada na refutação; no modo para trás, só essas são verificadas
+} ClausulaDrat;
+
+typedef struct {
+    int clausula;
+    char tipo;                  // 'a' adição, 'd' remoção, 'i' remoção ignorada
+} Passo;
+
+typedef struct {
+    int* itens;
+    int tamanho;
+    int capacidade;
+} ListaIds;
+
+typedef struct {
+    int num_variaveis;
+    int* literais;
+    long num_literais, capacidade_literais;
+    ClausulaDrat* clausulas;
+    int num_clausulas, capacidade_clausulas;
+    int num_originais;
+    Passo* passos;
+    int num_passos, capacidade_passos;
+
+    int* baldes;                // tabela das cláusulas vivas, encadeada por proxima
+    int* proxima;
+    int num_baldes, na_tabela;
+    char* marca;                // por literal, ao normalizar e comparar cláusulas
+    int capacidade_marca;
+    ListaIds temporario;        // literais do passo sendo lido ou da resolvente RAT
+
+    signed char* valor;         // por literal: 1, 0 ou -1
+    int* razao;                 // por variável: cláusula que a implicou
+    int* posicao;               // por variável: posição na trilha
+    int* trilha;
+    int tamanho_trilha, propagados;
+    int* trilha_antes;          // por passo: tamanho da trilha antes dele
+    ListaIds* observadores;     // por literal
+    char* visto;
+
+    long verificados, rat, ignoradas, nao_encontradas;
+} Verificador;
+
+static double agora() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void ids_adicionar(ListaIds* lista, int valor) {
+    if (lista->tamanho == lista->capacidade) {
+        lista->capacidade = lista->capacidade ? 2 * lista->capacidade : 4;
+        lista->itens = (int*)realloc(lista->itens, lista->capacidade * sizeof(int));
+    }
+    lista->itens[lista->tamanho++] = valor;
+}
+
+static int* literais_de(Verificador* v, int clausula) {
+    return v->literais + v->clausulas[clausula].inicio;
+}
+
+static unsigned espalhar_literal(int literal) {
+    return (unsigned)(((uint64_t)(unsigned)literal * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+static void garantir_variavel(Verificador* v, int variavel) {
+    if (variavel > v->num_variaveis) v->num_variaveis = variavel;
+    if (2 * variavel + 2 <= v->capacidade_marca) return;
+    int anterior = v->capacidade_marca;
+    while (v->capacidade_marca < 2 * variavel + 2) v->capacidade_marca = v->capacidade_marca ? 2 * v->capacidade_marca : 1024;
+    v->marca = (char*)realloc(v->marca, v->capacidade_marca);
+    memset(v->marca + anterior, 0, v->capacidade_marca - anterior);
+}
+
+// Tira literais repetidos de v->temporario. Retorna false se for tautologia.
+static bool normalizar(Verificador* v) {
+    ListaIds* t = &v->temporario;
+    int mantidos = 0;
+    bool tautologia = false;
+    for (int i = 0; i < t->tamanho; i++) {
+        int q = t->itens[i];
+        if (v->marca[q]) continue;
+        if (v->marca[q ^ 1]) tautologia = true;
+        v->marca[q] = 1;
+        t->itens[mantidos++] = q;
+    }
+    t->tamanho = mantidos;
+    for (int i = 0; i < mantidos; i++) v->marca[t->itens[i]] = 0;
+    return !tautologia;
+}
+
+static void tabela_inserir(Verificador* v, int clausula);
+
+static void tabela_crescer(Verificador* v) {
+    int* antigos = v->baldes;
+    int num_antigos = v->num_baldes;
+    v->num_baldes = num_antigos ? 2 * num_antigos : 1024;
+    v->baldes = (int*)malloc(v->num_baldes * sizeof(int));
+    for (int i = 0; i < v->num_baldes; i++) v->baldes[i] = -1;
+    v->na_tabela = 0;
+    for (int b = 0; b < num_antigos; b++) {
+        for (int c = antigos[b], seguinte; c >= 0; c = seguinte) {
+            seguinte = v->proxima[c];
+            tabela_inserir(v, c);
+        }
+    }
+    free(antigos);
+}
+
+static void tabela_inserir(Verificador* v, int clausula) {
+    if (v->na_tabela >= v->num_baldes) tabela_crescer(v);
+    int balde = (int)(v->clausulas[clausula].espalhamento & (unsigned)(v->num_baldes - 1));
+    v->proxima[clausula] = v->baldes[balde];
+    v->baldes[balde] = clausula;
+    v->na_tabela++;
+}
+
+// Procura e tira da tabela uma cláusula viva com os literais de v->temporario.
+static int tabela_remover(Verificador* v, unsigned espalhamento) {
+    if (v->num_baldes == 0) return -1;
+    ListaIds* t = &v->temporario;
+    for (int i = 0; i < t->tamanho; i++) v->marca[t->itens[i]] = 1;
+
+    int encontrada = -1;
+    int* elo = &v->baldes[espalhamento & (unsigned)(v->num_baldes - 1)];
+    for (; *elo >= 0; elo = &v->proxima[*elo]) {
+        const ClausulaDrat* c = &v->clausulas[*elo];
+        if (c->espalhamento != espalhamento || c->tamanho != t->tamanho) continue;
+        const int* literais = literais_de(v, *elo);
+        int iguais = 0;
+        while (iguais < c->tamanho && v->marca[literais[iguais]]) iguais++;
+        if (iguais == c->tamanho) {
+            encontrada = *elo;
+            *elo = v->proxima[encontrada];
+            v->na_tabela--;
+            break;
+        }
+    }
+    for (int i = 0; i < t->tamanho; i++) v->marca[t->itens[i]] = 0;
+    return encontrada;
+}
+
+// Guarda v->temporario (já normalizado) como cláusula nova.
+static int guardar_clausula(Verificador* v, int pivo) {
+    ListaIds* t = &v->temporario;
+    if (v->num_literais + t->tamanho > v->capacidade_literais) {
+        while (v->capacidade_literais < v->num_literais + t->tamanho) {
+            v->capacidade_literais = v->capacidade_literais ? 2 * v->capacidade_literais : 1 << 16;
+        }
+        v->literais = (int*)realloc(v->literais, v->capacidade_literais * sizeof(int));
+    }
+    if (v->num_clausulas == v->capacidade_clausulas) {
+        v->capacidade_clausulas = v->capacidade_clausulas ? 2 * v->capacidade_clausulas : 1024;
+        v->clausulas = (ClausulaDrat*)realloc(v->clausulas, v->capacidade_clausulas * sizeof(ClausulaDrat));
+        v->proxima = (int*)realloc(v->proxima, v->capacidade_clausulas * sizeof(int));
+    }
+
+    int id = v->num_clausulas++;
+    ClausulaDrat* c = &v->clausulas[id];
+    unsigned espalhamento = 0;
+    for (int i = 0; i < t->tamanho; i++) espalhamento += espalhar_literal(t->itens[i]);
+    *c = (ClausulaDrat){v->num_literais, t->tamanho, pivo, espalhamento, 0, 0};
+    memcpy(v->literais + v->num_literais, t->itens, t->tamanho * sizeof(int));
+    v->num_literais += t->tamanho;
+    tabela_inserir(v, id);
+    return id;
+}
+
+static void adicionar_passo(Verificador* v, char tipo, int clausula) {
+    if (v->num_passos == v->capacidade_passos) {
+        v->capacidade_passos = v->capacidade_passos ? 2 * v->capacidade_passos : 1024;
+        v->passos = (Passo*)realloc(v->passos, v->capacidade_passos * sizeof(Passo));
+    }
+    v->passos[v->num_passos++] = (Passo){clausula, tipo};
+}
+
+// Registra um passo da prova com os literais (codificados) de v->temporario.
+static void registrar_passo(Verificador* v, char tipo) {
+    int pivo = v->temporario.tamanho > 0 ? v->temporario.itens[0] : 0;
+    bool util = normalizar(v);
+    if (tipo == 'a') {
+        // Um lema tautológico é sempre válido e não muda nada.
+        if (util) adicionar_passo(v, 'a', guardar_clausula(v, pivo));
+        return;
+    }
+    unsigned espalhamento = 0;
+    for (int i = 0; i < v->temporario.tamanho; i++) espalhamento += espalhar_literal(v->temporario.itens[i]);
+    int clausula = util ? tabela_remover(v, espalhamento) : -1;
+    if (clausula < 0) v->nao_encontradas++;
+    else adicionar_passo(v, 'd', clausula);
+}
+
+static void erro_prova(const char* nome_arquivo, size_t posicao, const char* mensagem) {
+    printf("Erro em %s, byte %zu: %s\n", nome_arquivo, posicao, mensagem);
+    exit(2);
+}
+
+static void ler_prova_binaria(Verificador* v, const unsigned char* dados, size_t tamanho, const char* nome_arquivo) {
+    size_t p = 0;
+    while (p < tamanho) {
+        char tipo = (char)dados[p++];
+        if (tipo != 'a' && tipo != 'd') erro_prova(nome_arquivo, p - 1, "esperava 'a' ou 'd'");
+        v->temporario.tamanho = 0;
+        while (true) {
+            unsigned u = 0;
+            int deslocamento = 0;
+            do {
+                if (p == tamanho) erro_prova(nome_arquivo, p, "passo sem o 0 final");
+                if (deslocamento > 28) erro_prova(nome_arquivo, p, "literal grande demais");
+                u |= (unsigned)(dados[p] & 0x7F) << deslocamento;
+                deslocamento += 7;
+            } while (dados[p++] & 0x80);
+            if (u == 0) break;
+            if (u < 2 || u > (unsigned)INT_MAX) erro_prova(nome_arquivo, p, "literal inválido");
+            garantir_variavel(v, (int)(u >> 1));
+            ids_adicionar(&v->temporario, (int)u);
+        }
+        registrar_passo(v, tipo);
+    }
+}
+
+static void ler_prova_texto(Verificador* v, const char* dados, size_t tamanho, const char* nome_arquivo) {
+    LeitorDimacs leitor = {dados, dados, dados + tamanho, nome_arquivo};
+    while (pular_espacos(&leitor)) {
+        char tipo = 'a';
+        if (*leitor.p == 'd') {
+            tipo = 'd';
+            leitor.p++;
+        }
+        v->temporario.tamanho = 0;
+        while (true) {
+            if (!pular_espacos(&leitor)) erro_dimacs(&leitor, "passo sem o 0 final");
+            int literal = ler_inteiro(&leitor);
+            if (literal == 0) break;
+            garantir_variavel(v, abs(literal));
+            ids_adicionar(&v->temporario, literal > 0 ? 2 * literal : -2 * literal + 1);
+        }
+        registrar_passo(v, tipo);
+    }
+}
+
+// Lê a prova inteira: binária se houver um byte 0 no começo (o texto nunca tem).
+static void ler_prova(Verificador* v, const char* nome_arquivo) {
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
+        exit(2);
+    }
+    size_t tamanho;
+    char* dados = ler_descritor(fd, &tamanho);
+    close(fd);
+    if (dados == NULL) {
+        printf("Erro ao ler o arquivo %s\n", nome_arquivo);
+        exit(2);
+    }
+    bool binaria = tamanho > 0 && memchr(dados, 0, tamanho < 1024 ? tamanho : 1024) != NULL;
+    if (binaria) ler_prova_binaria(v, (const unsigned char*)dados, tamanho, nome_arquivo);
+    else ler_prova_texto(v, dados, tamanho, nome_arquivo);
+    free(dados);
+}
+
+static void atribuir(Verificador* v, int literal, int razao) {
+    v->valor[literal] = 1;
+    v->valor[literal ^ 1] = 0;
+    v->razao[literal >> 1] = razao;
+    v->posicao[literal >> 1] = v->tamanho_trilha;
+    v->trilha[v->tamanho_trilha++] = literal;
+}
+
+// Desfaz a trilha até "tamanho".
+static void truncar(Verificador* v, int tamanho) {
+    while (v->tamanho_trilha > tamanho) {
+        int literal = v->trilha[--v->tamanho_trilha];
+        v->valor[literal] = v->valor[literal ^ 1] = -1;
+    }
+    v->propagados = tamanho;
+}
+
+// Propagação com dois literais observados (as posições 0 e 1 de cada cláusula).
+// Retorna a cláusula em conflito ou -1.
+static int propagar(Verificador* v) {
+    while (v->propagados < v->tamanho_trilha) {
+        int falso = v->trilha[v->propagados++] ^ 1;
+        ListaIds* lista = &v->observadores[falso];
+        int mantidos = 0;
+        for (int k = 0; k < lista->tamanho; k++) {
+            int id = lista->itens[k];
+            int* literais = literais_de(v, id);
+            int tamanho = v->clausulas[id].tamanho;
+            if (literais[0] == falso) {
+                literais[0] = literais[1];
+                literais[1] = falso;
+            }
+            if (v->valor[literais[0]] == 1) {
+                lista->itens[mantidos++] = id;
+                continue;
+            }
+            int i = 2;
+            while (i < tamanho && v->valor[literais[i]] == 0) i++;
+            if (i < tamanho) {
+                literais[1] = literais[i];
+                literais[i] = falso;
+                ids_adicionar(&v->observadores[literais[1]], id);
+                continue;
+            }
+            lista->itens[mantidos++] = id;
+            if (v->valor[literais[0]] == 0) {
+                while (++k < lista->tamanho) lista->itens[mantidos++] = lista->itens[k];
+                lista->tamanho = mantidos;
+                v->propagados = v->tamanho_trilha;
+                return id;
+            }
+            atribuir(v, literais[0], id);
+        }
+        lista->tamanho = mantidos;
+    }
+    return -1;
+}
+
+// Põe nas posições 0 e 1 os melhores observados: não falsos primeiro, depois os
+// falsos atribuídos mais tarde (desfeitos antes ao truncar a trilha).
+static void escolher_observados(Verificador* v, int* literais, int tamanho) {
+    for (int k = 0; k < 2; k++) {
+        int melhor = k;
+        for (int i = k + 1; i < tamanho && v->valor[literais[melhor]] == 0; i++) {
+            if (v->valor[literais[i]] != 0) melhor = i;
+        }
+        if (v->valor[literais[melhor]] == 0) {
+            // Todos falsos a partir de k: o atribuído por último.
+            for (int i = k + 1; i < tamanho; i++) {
+                if (v->posicao[literais[i] >> 1] > v->posicao[literais[melhor] >> 1]) melhor = i;
+            }
+        }
+        int troca = literais[k];
+        literais[k] = literais[melhor];
+        literais[melhor] = troca;
+    }
+}
+
+// Torna a cláusula viva e propaga no nível atual. Retorna a cláusula em
+// conflito ou -1.
+static int ativar(Verificador* v, int id) {
+    ClausulaDrat* c = &v->clausulas[id];
+    int* literais = literais_de(v, id);
+    c->ativa = 1;
+    if (c->tamanho == 0) return id;
+    if (c->tamanho == 1) {
+        if (v->valor[literais[0]] == 0) return id;
+        if (v->valor[literais[0]] == -1) atribuir(v, literais[0], id);
+        return propagar(v);
+    }
+    escolher_observados(v, literais, c->tamanho);
+    ids_adicionar(&v->observadores[literais[0]], id);
+    ids_adicionar(&v->observadores[literais[1]], id);
+    if (v->valor[literais[0]] == 0) return id;
+    if (v->valor[literais[1]] == 0 && v->valor[literais[0]] == -1) atribuir(v, literais[0], id);
+    return propagar(v);
+}
+
+static void tirar_observador(ListaIds* lista, int id) {
+    for (int k = 0; k < lista->tamanho; k++) {
+        if (lista->itens[k] == id) {
+            lista->itens[k] = lista->itens[--lista->tamanho];
+            return;
+        }
+    }
+}
+
+static void desativar(Verificador* v, int id) {
+    ClausulaDrat* c = &v->clausulas[id];
+    c->ativa = 0;
+    if (c->tamanho < 2) return;
+    int* literais = literais_de(v, id);
+    tirar_observador(&v->observadores[literais[0]], id);
+    tirar_observador(&v->observadores[literais[1]], id);
+}
+
+// A cláusula é razão de alguma atribuição (sempre a do literal na posição 0).
+static bool eh_razao(Verificador* v, int id) {
+    const ClausulaDrat* c = &v->clausulas[id];
+    if (c->tamanho == 0) return false;
+    int primeiro = literais_de(v, id)[0];
+    return v->valor[primeiro] == 1 && v->razao[primeiro >> 1] == id;
+}
+
+// Marca as cláusulas que levaram ao conflito (ou a tornar "verdadeiro"
+// verdadeiro), andando para trás na trilha pelas razões.
+static void marcar_usadas(Verificador* v, int conflito, int verdadeiro) {
+    int pendentes = 0;
+    if (conflito >= 0) {
+        v->clausulas[conflito].marcada = 1;
+        const int* literais = literais_de(v, conflito);
+        for (int i = 0; i < v->clausulas[conflito].tamanho; i++) {
+            if (!v->visto[literais[i] >> 1]) {
+                v->visto[literais[i] >> 1] = 1;
+                pendentes++;
+            }
+        }
+    } else {
+        v->visto[verdadeiro >> 1] = 1;
+        pendentes = 1;
+    }
+
+    for (int j = v->tamanho_trilha - 1; j >= 0 && pendentes > 0; j--) {
+        int x = v->trilha[j] >> 1;
+        if (!v->visto[x]) continue;
+        v->visto[x] = 0;
+        pendentes--;
+        int razao = v->razao[x];
+        if (razao < 0) continue;
+        v->clausulas[razao].marcada = 1;
+        const int* literais = literais_de(v, razao);
+        for (int i = 0; i < v->clausulas[razao].tamanho; i++) {
+            int y = literais[i] >> 1;
+            if (y != x && !v->visto[y]) {
+                v->visto[y] = 1;
+                pendentes++;
+            }
+        }
+    }
+}
+
+// O lema é RUP: atribuir a negação dos seus literais e propagar dá conflito.
+static bool verificar_rup(Verificador* v, const int* lema, int tamanho, bool marcar) {
+    int base = v->tamanho_trilha;
+    int verdadeiro = -1, conflito = -1;
+    for (int i = 0; i < tamanho && verdadeiro < 0; i++) {
+        if (v->valor[lema[i]] == 1) verdadeiro = lema[i];
+        else if (v->valor[lema[i]] == -1) atribuir(v, lema[i] ^ 1, RAZAO_SUPOSICAO);
+    }
+    if (verdadeiro < 0) conflito = propagar(v);
+    bool valido = verdadeiro >= 0 || conflito >= 0;
+    if (valido && marcar) marcar_usadas(v, conflito, verdadeiro);
+    truncar(v, base);
+    return valido;
+}
+
+// RAT no pivô: cada resolvente com uma cláusula viva que contém o pivô negado é RUP.
+static bool verificar_rat(Verificador* v, int id, bool marcar) {
+    const ClausulaDrat* lema = &v->clausulas[id];
+    int pivo = lema->pivo;
+    if (lema->tamanho == 0) return false;
+
+    for (int outra = 0; outra < v->num_clausulas; outra++) {
+        const ClausulaDrat* d = &v->clausulas[outra];
+        if (!d->ativa || outra == id) continue;
+        const int* literais_d = literais_de(v, outra);
+        bool contem = false;
+        for (int i = 0; i < d->tamanho && !contem; i++) contem = literais_d[i] == (pivo ^ 1);
+        if (!contem) continue;
+
+        ListaIds* t = &v->temporario;
+        t->tamanho = 0;
+        const int* literais = literais_de(v, id);
+        for (int i = 0; i < lema->tamanho; i++) ids_adicionar(t, literais[i]);
+        for (int i = 0; i < d->tamanho; i++) {
+            if (literais_d[i] != (pivo ^ 1)) ids_adicionar(t, literais_d[i]);
+        }
+        if (!normalizar(v)) continue;
+        if (!verificar_rup(v, t->itens, t->tamanho, marcar)) return false;
+        if (marcar) v->clausulas[outra].marcada = 1;
+    }
+    return true;
+}
+
+static bool verificar_lema(Verificador* v, int id, bool marcar) {
+    v->verificados++;
+    if (verificar_rup(v, literais_de(v, id), v->clausulas[id].tamanho, marcar)) return true;
+    v->rat++;
+    return verificar_rat(v, id, marcar);
+}
+
+static void preparar_atribuicoes(Verificador* v) {
+    int n = v->num_variaveis;
+    v->valor = (signed char*)malloc(2 * (n + 1));
+    memset(v->valor, -1, 2 * (n + 1));
+    v->razao = (int*)malloc((n + 1) * sizeof(int));
+    v->posicao = (int*)malloc((n + 1) * sizeof(int));
+    v->trilha = (int*)malloc((n + 1) * sizeof(int));
+    v->visto = (char*)calloc(n + 1, 1);
+    v->observadores = (ListaIds*)calloc(2 * (n + 1), sizeof(ListaIds));
+    v->trilha_antes = (int*)malloc((v->num_passos + 1) * sizeof(int));
+}
+
+static void verificador_liberar(Verificador* v) {
+    for (int literal = 0; literal <= 2 * v->num_variaveis + 1; literal++) free(v->observadores[literal].itens);
+    free(v->observadores);
+    free(v->literais);
+    free(v->clausulas);
+    free(v->passos);
+    free(v->baldes);
+    free(v->proxima);
+    free(v->marca);
+    free(v->temporario.itens);
+    free(v->valor);
+    free(v->razao);
+    free(v->posicao);
+    free(v->trilha);
+    free(v->trilha_antes);
+    free(v->visto);
+}
+
+// Aplica a prova (verificando cada lema se "para_frente") até o primeiro
+// conflito no nível 0. Retorna o passo do conflito (-1: já nas originais), ou
+// -2 se a prova não chega a um conflito, ou -3 se um lema falhou.
+static int aplicar_prova(Verificador* v, bool para_frente, int* conflito) {
+    *conflito = -1;
+    for (int id = 0; id < v->num_originais && *conflito < 0; id++) *conflito = ativar(v, id);
+    if (*conflito >= 0) return -1;
+
+    for (int i = 0; i < v->num_passos; i++) {
+        Passo* passo = &v->passos[i];
+        v->trilha_antes[i] = v->tamanho_trilha;
+        if (passo->tipo == 'a') {
+            if (para_frente && !verificar_lema(v, passo->clausula, false)) {
+                printf("c lema %d (passo %d) não é RUP nem RAT\n", passo->clausula - v->num_originais + 1, i + 1);
+                return -3;
+            }
+            *conflito = ativar(v, passo->clausula);
+            if (*conflito >= 0) return i;
+        } else if (eh_razao(v, passo->clausula)) {
+            passo->tipo = 'i';
+            v->ignoradas++;
+        } else {
+            desativar(v, passo->clausula);
+        }
+    }
+    return -2;
+}
+
+// Desfaz a prova do passo "fim" até o começo, verificando os lemas marcados.
+static bool verificar_para_tras(Verificador* v, int fim) {
+    for (int i = fim; i >= 0; i--) {
+        Passo* passo = &v->passos[i];
+        truncar(v, v->trilha_antes[i]);
+        if (passo->tipo == 'a') {
+            desativar(v, passo->clausula);
+            if (v->clausulas[passo->clausula].marcada && !verificar_lema(v, passo->clausula, true)) {
+                printf("c lema %d (passo %d) não é RUP nem RAT\n", passo->clausula - v->num_originais + 1, i + 1);
+                return false;
+            }
+        } else if (passo->tipo == 'd') {
+            // Ao voltar, a cláusula removida volta a valer; na trilha deste
+            // ponto ela já não é unitária, então basta observá-la de novo.
+            ClausulaDrat* c = &v->clausulas[passo->clausula];
+            c->ativa = 1;
+            if (c->tamanho >= 2) {
+                int* literais = literais_de(v, passo->clausula);
+                escolher_observados(v, literais, c->tamanho);
+                ids_adicionar(&v->observadores[literais[0]], passo->clausula);
+                ids_adicionar(&v->observadores[literais[1]], passo->clausula);
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool para_frente = false;
+    const char* arquivos[2];
+    int num_arquivos = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0) para_frente = true;
+        else if (num_arquivos < 2) arquivos[num_arquivos++] = argv[i];
+    }
+    if (num_arquivos < 2) {
+        printf("Uso: %s [-f] formula.cnf prova.drat\n", argv[0]);
+        return 2;
+    }
+
+    double inicio = agora();
+    Verificador v;
+    memset(&v, 0, sizeof(v));
+    Formula F = ler_dimacs(arquivos[0], NULL);
+    garantir_variavel(&v, F.num_variaveis);
+    for (int i = 0; i < F.num_clausulas; i++) {
+        v.temporario.tamanho = 0;
+        for (int j = 0; j < F.clausulas[i].num_literais; j++) {
+            int literal = F.clausulas[i].literais[j];
+            ids_adicionar(&v.temporario, literal > 0 ? 2 * literal : -2 * literal + 1);
+        }
+        if (normalizar(&v)) guardar_clausula(&v, 0);
+    }
+    v.num_originais = v.num_clausulas;
+    liberar_formula(&F);
+    ler_prova(&v, arquivos[1]);
+    double leitura = agora() - inicio;
+
+    preparar_atribuicoes(&v);
+    int conflito;
+    int fim = aplicar_prova(&v, para_frente, &conflito);
+    bool verificada = fim >= -1;
+    if (fim == -2) printf("c a prova não chega à cláusula vazia\n");
+    if (verificada && !para_frente) {
+        marcar_usadas(&v, conflito, -1);
+        verificada = verificar_para_tras(&v, fim);
+    }
+
+    long lemas = 0, usados = 0;
+    for (int id = v.num_originais; id < v.num_clausulas; id++) {
+        lemas++;
+        usados += v.clausulas[id].marcada;
+    }
+    printf("c %d cláusulas, %ld lemas (%ld verificados%s, %ld por RAT), %ld remoções ignoradas, "
+           "%ld não encontradas\n", v.num_originais, lemas, v.verificados,
+           para_frente ? "" : " para trás", v.rat, v.ignoradas, v.nao_encontradas);
+    if (!para_frente) printf("c %ld lemas usados na refutação\n", usados);
+    printf("c leitura em %.3f s, verificação em %.3f s\n", leitura, agora() - inicio - leitura);
+    printf("s %s\n", verificada ? "VERIFICADA" : "NÃO VERIFICADA");
+    verificador_liberar(&v);
+    return verificada ? 0 : 1;
+}